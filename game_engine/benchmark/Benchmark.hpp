@@ -0,0 +1,63 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hlt {
+namespace benchmark {
+
+/**
+ * The body of a benchmark.
+ * Runs the measured operation the given number of times.
+ */
+using Body = std::function<void(size_t iterations)>;
+
+/** A named benchmark. */
+struct Benchmark {
+    std::string name; /**< The name of the benchmark. */
+    Body body;        /**< The body of the benchmark. */
+};
+
+/**
+ * Get all registered benchmarks, in registration order.
+ * @return The benchmarks.
+ */
+std::vector<Benchmark> &registry();
+
+/** Registers a benchmark on construction. */
+struct Registration {
+    /**
+     * Register a benchmark.
+     * @param name The name of the benchmark.
+     * @param body The body of the benchmark.
+     */
+    Registration(std::string name, Body body) {
+        registry().push_back({std::move(name), std::move(body)});
+    }
+};
+
+/**
+ * Prevent the compiler from optimizing away a value.
+ * @tparam T The type of the value.
+ * @param value The value.
+ */
+template<class T>
+inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+}
+}
+
+/** Register a function taking an iteration count as a benchmark. */
+#define HLT_BENCHMARK(function) \
+    static const hlt::benchmark::Registration function##_registration{#function, function}
+
+#endif // BENCHMARK_HPP
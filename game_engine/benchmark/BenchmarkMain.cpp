@@ -0,0 +1,52 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "Benchmark.hpp"
+
+namespace hlt {
+namespace benchmark {
+
+/**
+ * Get all registered benchmarks, in registration order.
+ * @return The benchmarks.
+ */
+std::vector<Benchmark> &registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+}
+}
+
+/**
+ * Run every benchmark whose name contains the filter given as the first argument, or all of them.
+ * Iterations are doubled until a run takes long enough to time reliably.
+ */
+int main(int argc, char *argv[]) {
+    using Clock = std::chrono::steady_clock;
+    static constexpr auto MIN_DURATION = std::chrono::milliseconds(250);
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    for (const auto &[name, body] : hlt::benchmark::registry()) {
+        if (name.find(filter) == std::string::npos) {
+            continue;
+        }
+        size_t iterations = 1;
+        Clock::duration elapsed{};
+        while (true) {
+            const auto start = Clock::now();
+            body(iterations);
+            elapsed = Clock::now() - start;
+            if (elapsed >= MIN_DURATION) {
+                break;
+            }
+            iterations *= 2;
+        }
+        const auto nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+        std::cout << std::left << std::setw(48) << name
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(1)
+                  << nanoseconds / iterations << " ns/op" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <sstream>
+
+#include "Benchmark.hpp"
+#include "CommandParser.hpp"
+
+using hlt::benchmark::do_not_optimize;
+
+namespace {
+
+/** The number of ships commanded by the bot. */
+constexpr size_t SHIPS = 200;
+
+/**
+ * Build the command line of a bot moving every ship and spawning.
+ * @return The command line.
+ */
+std::string command_line() {
+    static constexpr char DIRECTIONS[] = {'n', 's', 'e', 'w', 'o'};
+    std::string line;
+    for (size_t ship = 0; ship < SHIPS; ship++) {
+        line += "m " + std::to_string(ship * 7) + " " + DIRECTIONS[ship % sizeof(DIRECTIONS)] + " ";
+    }
+    line += "g";
+    return line;
+}
+
+/**
+ * Decode commands through stream extraction, one command at a time.
+ * @param iterations The number of lines to decode.
+ */
+void command_parse_stream(size_t iterations) {
+    const auto line = command_line();
+    for (size_t i = 0; i < iterations; i++) {
+        std::vector<hlt::Command> commands;
+        std::istringstream stream(line);
+        hlt::Command command;
+        while (stream >> command) {
+            commands.push_back(std::move(command));
+        }
+        do_not_optimize(commands.size());
+    }
+}
+
+/**
+ * Decode commands with the reused tokenizer buffer.
+ * @param iterations The number of lines to decode.
+ */
+void command_parse_tokenizer(size_t iterations) {
+    const auto line = command_line();
+    hlt::CommandParser parser;
+    for (size_t i = 0; i < iterations; i++) {
+        do_not_optimize(parser.parse(line).size());
+    }
+}
+
+}
+
+HLT_BENCHMARK(command_parse_stream);
+HLT_BENCHMARK(command_parse_tokenizer);
@@ -0,0 +1,59 @@
+#include <future>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ThreadPool.hpp"
+
+using hlt::benchmark::do_not_optimize;
+
+namespace {
+
+/** The number of players whose bots are contacted every turn. */
+constexpr size_t PLAYERS = 4;
+
+/**
+ * Stand-in for the per-turn exchange with one bot.
+ * @param player The player.
+ * @return The result of the exchange.
+ */
+size_t exchange(size_t player) {
+    return player * 2 + 1;
+}
+
+/**
+ * Dispatch the players of a turn to a new thread each, as std::async does.
+ * @param iterations The number of turns.
+ */
+void turn_dispatch_async(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        std::vector<std::future<size_t>> results;
+        for (size_t player = 0; player < PLAYERS; player++) {
+            results.emplace_back(std::async(std::launch::async, [player] { return exchange(player); }));
+        }
+        for (auto &result : results) {
+            do_not_optimize(result.get());
+        }
+    }
+}
+
+/**
+ * Dispatch the players of a turn to persistent threads.
+ * @param iterations The number of turns.
+ */
+void turn_dispatch_thread_pool(size_t iterations) {
+    ThreadPool pool(PLAYERS);
+    for (size_t i = 0; i < iterations; i++) {
+        std::vector<std::future<size_t>> results;
+        for (size_t player = 0; player < PLAYERS; player++) {
+            results.emplace_back(pool.run([player] { return exchange(player); }));
+        }
+        for (auto &result : results) {
+            do_not_optimize(result.get());
+        }
+    }
+}
+
+}
+
+HLT_BENCHMARK(turn_dispatch_async);
+HLT_BENCHMARK(turn_dispatch_thread_pool);
@@ -0,0 +1,152 @@
+#include "Benchmark.hpp"
+#include "Map.hpp"
+
+using namespace hlt;
+using hlt::benchmark::do_not_optimize;
+
+namespace {
+
+/** The dimension of the benchmark maps, the largest in the default rotation. */
+constexpr dimension_type DIMENSION = 64;
+/** An awkward dimension, where a power of two stride pads each row. */
+constexpr dimension_type ODD_DIMENSION = 56;
+
+/** The previous grid layout, a vector of row vectors, kept for comparison. */
+struct NestedGrid {
+    dimension_type width;                /**< The width of the grid. */
+    dimension_type height;               /**< The height of the grid. */
+    std::vector<std::vector<Cell>> grid; /**< The rows of the grid. */
+
+    NestedGrid(dimension_type width, dimension_type height) :
+            width(width), height(height),
+            grid(static_cast<size_t>(height), std::vector<Cell>(static_cast<size_t>(width))) {}
+
+    const Cell &at(dimension_type x, dimension_type y) const { return grid[y][x]; }
+};
+
+/**
+ * Fill a grid with varying energy.
+ * @tparam G The type of the grid.
+ * @tparam At The type of the accessor.
+ * @param grid The grid.
+ * @param at Accessor for the mutable energy of a cell.
+ */
+template<class G, class At>
+void fill(G &grid, At at) {
+    for (dimension_type y = 0; y < grid.height; y++) {
+        for (dimension_type x = 0; x < grid.width; x++) {
+            at(grid, x, y) = (x * 31 + y * 17) % 1000;
+        }
+    }
+}
+
+/**
+ * Sum the energy of a grid through coordinate lookups.
+ * @tparam G The type of the grid.
+ * @param grid The grid.
+ * @param iterations The number of scans.
+ */
+template<class G>
+void scan(const G &grid, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        energy_type total = 0;
+        for (dimension_type y = 0; y < grid.height; y++) {
+            for (dimension_type x = 0; x < grid.width; x++) {
+                total += grid.at(x, y).energy;
+            }
+        }
+        do_not_optimize(total);
+    }
+}
+
+/**
+ * Sum the energy of the neighbors of every cell of a map.
+ * @param map The map.
+ * @param iterations The number of scans.
+ */
+void neighbor_scan(const Map &map, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        energy_type total = 0;
+        for (dimension_type y = 0; y < map.height; y++) {
+            for (dimension_type x = 0; x < map.width; x++) {
+                for (const auto &neighbor : map.get_neighbors({x, y})) {
+                    total += map.at(neighbor).energy;
+                }
+            }
+        }
+        do_not_optimize(total);
+    }
+}
+
+void nested_grid_scan(size_t iterations) {
+    NestedGrid grid(DIMENSION, DIMENSION);
+    fill(grid, [](auto &g, auto x, auto y) -> energy_type & { return g.grid[y][x].energy; });
+    scan(grid, iterations);
+}
+
+void flat_grid_scan(size_t iterations) {
+    Grid<Cell> grid(DIMENSION, DIMENSION);
+    fill(grid, [](auto &g, auto x, auto y) -> energy_type & { return g.at(x, y).energy; });
+    scan(grid, iterations);
+}
+
+void map_cell_scan(size_t iterations) {
+    Map map(DIMENSION, DIMENSION);
+    fill(map, [](auto &g, auto x, auto y) -> energy_type & { return g.energy.at(x, y); });
+    scan(map, iterations);
+}
+
+void map_energy_plane_scan(size_t iterations) {
+    Map map(DIMENSION, DIMENSION);
+    fill(map, [](auto &g, auto x, auto y) -> energy_type & { return g.energy.at(x, y); });
+    for (size_t i = 0; i < iterations; i++) {
+        do_not_optimize(map.total_energy());
+    }
+}
+
+void nested_grid_scan_56(size_t iterations) {
+    NestedGrid grid(ODD_DIMENSION, ODD_DIMENSION);
+    fill(grid, [](auto &g, auto x, auto y) -> energy_type & { return g.grid[y][x].energy; });
+    scan(grid, iterations);
+}
+
+void flat_grid_scan_56(size_t iterations) {
+    Grid<Cell> grid(ODD_DIMENSION, ODD_DIMENSION);
+    fill(grid, [](auto &g, auto x, auto y) -> energy_type & { return g.at(x, y).energy; });
+    scan(grid, iterations);
+}
+
+void power_of_two_stride_grid_scan_56(size_t iterations) {
+    Grid<Cell> grid(ODD_DIMENSION, ODD_DIMENSION, true);
+    fill(grid, [](auto &g, auto x, auto y) -> energy_type & { return g.at(x, y).energy; });
+    scan(grid, iterations);
+}
+
+void map_neighbor_scan(size_t iterations) {
+    Map map(DIMENSION, DIMENSION);
+    fill(map, [](auto &g, auto x, auto y) -> energy_type & { return g.energy.at(x, y); });
+    neighbor_scan(map, iterations);
+}
+
+void map_move_location(size_t iterations) {
+    const Map map(DIMENSION, DIMENSION);
+    static constexpr Direction DIRECTIONS[] = {Direction::North, Direction::East, Direction::East,
+                                               Direction::South, Direction::West};
+    Location location{0, 0};
+    for (size_t i = 0; i < iterations; i++) {
+        map.move_location(location, DIRECTIONS[i % 5]);
+        do_not_optimize(location);
+    }
+}
+
+}
+
+HLT_BENCHMARK(nested_grid_scan);
+HLT_BENCHMARK(flat_grid_scan);
+HLT_BENCHMARK(map_cell_scan);
+HLT_BENCHMARK(map_energy_plane_scan);
+HLT_BENCHMARK(nested_grid_scan_56);
+HLT_BENCHMARK(flat_grid_scan_56);
+HLT_BENCHMARK(power_of_two_stride_grid_scan_56);
+HLT_BENCHMARK(map_neighbor_scan);
+HLT_BENCHMARK(map_move_location);
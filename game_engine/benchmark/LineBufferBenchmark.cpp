@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+#include "Benchmark.hpp"
+#include "LineBuffer.hpp"
+
+using hlt::benchmark::do_not_optimize;
+
+namespace {
+
+/** The size of each read from the bot, that of a default pipe. */
+constexpr size_t READ_SIZE = 64 * 1024;
+
+/** The number of ships commanded by the bot, giving a line of about a megabyte. */
+constexpr size_t SHIPS = 100000;
+
+/**
+ * Build the command line of a bot moving a very large fleet, with its newline.
+ * @return The command line.
+ */
+std::string command_line() {
+    std::string line;
+    for (size_t ship = 0; ship < SHIPS; ship++) {
+        line += "m " + std::to_string(ship) + " n ";
+    }
+    line += "g\n";
+    return line;
+}
+
+/**
+ * Split lines by copying reads into strings queued in a deque, as the engine used to.
+ * @param iterations The number of lines to split.
+ */
+void line_split_deque(size_t iterations) {
+    const auto input = command_line();
+    std::string current_read;
+    std::deque<std::string> message_queue;
+    for (size_t i = 0; i < iterations; i++) {
+        for (size_t offset = 0; offset < input.size(); offset += READ_SIZE) {
+            // The read lands in a fixed buffer, and is then split by searching for newlines
+            const auto data = input.data() + offset;
+            const auto end = data + std::min(READ_SIZE, input.size() - offset);
+            auto start = data;
+            while (true) {
+                const auto newline_pos = std::find(start, end, '\n');
+                current_read.append(start, newline_pos);
+                if (newline_pos == end) {
+                    break;
+                }
+                message_queue.push_back(std::move(current_read));
+                current_read.clear();
+                start = newline_pos + 1;
+            }
+        }
+        const auto message = std::move(message_queue.front());
+        message_queue.pop_front();
+        do_not_optimize(message.size());
+    }
+}
+
+/**
+ * Split lines read straight into the ring of a LineBuffer.
+ * @param iterations The number of lines to split.
+ */
+void line_split_ring(size_t iterations) {
+    const auto input = command_line();
+    net::LineBuffer lines;
+    std::string_view message;
+    for (size_t i = 0; i < iterations; i++) {
+        for (size_t offset = 0; offset < input.size();) {
+            // The read lands in the ring itself
+            const auto [space, space_length] = lines.reserve();
+            const auto length = std::min({READ_SIZE, space_length, input.size() - offset});
+            std::memcpy(space, input.data() + offset, length);
+            lines.commit(length);
+            offset += length;
+            lines.pop(message);
+        }
+        do_not_optimize(message.size());
+    }
+}
+
+}
+
+HLT_BENCHMARK(line_split_deque);
+HLT_BENCHMARK(line_split_ring);
@@ -10,6 +10,27 @@
 
 namespace hlt {
 
+thread_local Constants *Constants::current = nullptr;
+
+/** Make a private copy of the current constants current. */
+Constants::Scope::Scope() : owned(new Constants()), previous(current) {
+    *owned = get();
+    current = owned.get();
+}
+
+/**
+ * Make existing constants current, such as those of a game on its helper threads.
+ * @param constants The constants, which must outlive the scope.
+ */
+Constants::Scope::Scope(Constants &constants) : previous(current) {
+    current = &constants;
+}
+
+/** Restore the previously current constants. */
+Constants::Scope::~Scope() {
+    current = previous;
+}
+
 /**
  * Encode the constants to JSON.
  * @param[out] json The JSON output.
@@ -1,6 +1,8 @@
 #ifndef CONSTANTS_HPP
 #define CONSTANTS_HPP
 
+#include <memory>
+
 #include "Units.hpp"
 
 #include "nlohmann/json_fwd.hpp"
@@ -71,16 +73,45 @@ struct Constants {
     static constexpr double BLUR_FACTOR = 0.75; // Not part of canon, needed to compile
 
     /**
-     * Get the singleton constants.
-     * @return The singleton constants.
+     * Makes constants current on this thread for its lifetime, so that games
+     * running concurrently in one process each see their own constants.
+     * Scopes nest; the previously current constants are restored on destruction.
+     */
+    class Scope {
+        std::unique_ptr<Constants> owned; /**< The constants owned by this scope, if any. */
+        Constants *previous;              /**< The constants current before this scope. */
+    public:
+        /** Make a private copy of the current constants current. */
+        Scope();
+
+        /**
+         * Make existing constants current, such as those of a game on its helper threads.
+         * @param constants The constants, which must outlive the scope.
+         */
+        explicit Scope(Constants &constants);
+
+        /** Restore the previously current constants. */
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    /**
+     * Get the current constants.
+     * @return The current constants.
      */
     static const Constants &get() { return get_mut(); }
 
     /**
-     * Get a mutable reference to the singleton constants.
-     * @return Mutable reference to the singleton constants.
+     * Get a mutable reference to the current constants.
+     * These are those of the innermost Scope on this thread, or else the process-wide ones.
+     * @return Mutable reference to the current constants.
      */
     static Constants &get_mut() {
+        if (current != nullptr) {
+            return *current;
+        }
         // Guaranteed initialized only once by C++11
         static Constants instance;
         return instance;
@@ -104,6 +135,9 @@ struct Constants {
     Constants(const Constants &) = delete;
 
 private:
+    /** The constants of the innermost Scope on this thread, if any. */
+    static thread_local Constants *current;
+
     /** Hide the default constructor. */
     Constants() = default;
 };
@@ -7,11 +7,14 @@ using namespace std::literals::chrono_literals;
 
 namespace net {
 
+class ConnectionPool;
+
 /** Configuration for the networking suite. */
 struct NetworkingConfig {
     bool ignore_timeout{};                       /**< Ignore timeouts in network actions. */
     std::chrono::milliseconds timeout = 2000ms;  /**< The networking timeout duration. */
     unsigned long name_max_length = 30;          /**< Maximum permissible length for user name in characters. */
+    ConnectionPool *pool{};                      /**< Bots kept between games, or null to launch bots for each game. */
 };
 
 }
@@ -0,0 +1,24 @@
+#include "CellSet.hpp"
+
+namespace hlt {
+
+/**
+ * Empty the set and prepare it for a grid.
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ */
+void CellSet::reset(dimension_type width, dimension_type height) {
+    this->width = width;
+    cells.clear();
+    members.assign(static_cast<size_t>(width * height), false);
+}
+
+/** Empty the set, keeping its storage. */
+void CellSet::clear() {
+    for (const auto &location : cells) {
+        members[index(location)] = false;
+    }
+    cells.clear();
+}
+
+}
@@ -0,0 +1,99 @@
+#ifndef CELLSET_HPP
+#define CELLSET_HPP
+
+#include <cassert>
+#include <vector>
+
+#include "Location.hpp"
+
+namespace hlt {
+
+/**
+ * A set of cells of a grid, kept in the order they were added.
+ *
+ * Membership is marked on a plane over the grid, so adding a cell is O(1) without hashing,
+ * and clearing touches only the cells in the set. Storage is kept when the set is cleared,
+ * so a set refilled every turn stops allocating once it has held its largest contents.
+ */
+class CellSet {
+    dimension_type width{};      /**< The width of the grid. */
+    std::vector<Location> cells; /**< The cells in the set, in the order added. */
+    std::vector<char> members;   /**< Whether each cell is in the set, row-major. */
+
+    /**
+     * Get the index of a cell on the membership plane.
+     * @param location The cell.
+     * @return The index.
+     */
+    size_t index(const Location &location) const {
+        return static_cast<size_t>(location.y * width + location.x);
+    }
+
+public:
+    /** The type of iterators over the cells. */
+    using const_iterator = std::vector<Location>::const_iterator;
+
+    /**
+     * Empty the set and prepare it for a grid.
+     * @param width The width of the grid.
+     * @param height The height of the grid.
+     */
+    void reset(dimension_type width, dimension_type height);
+
+    /**
+     * Add a cell, if it is not in the set already.
+     * @param location The cell, which must be on the grid.
+     */
+    void insert(const Location &location) {
+        const auto cell = index(location);
+        assert(cell < members.size());
+        if (!members[cell]) {
+            members[cell] = true;
+            cells.push_back(location);
+        }
+    }
+
+    /**
+     * Replace the contents of the set.
+     * @param first The first cell, which must not repeat another.
+     * @param last The end of the cells.
+     */
+    template<class InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /** Empty the set, keeping its storage. */
+    void clear();
+
+    /**
+     * Get the number of cells in the set.
+     * @return The number of cells.
+     */
+    size_t size() const { return cells.size(); }
+
+    /**
+     * Check whether the set is empty.
+     * @return True if the set has no cells.
+     */
+    bool empty() const { return cells.empty(); }
+
+    /**
+     * Get an iterator to the first cell.
+     * @return The iterator.
+     */
+    const_iterator begin() const { return cells.begin(); }
+
+    /**
+     * Get the iterator past the last cell.
+     * @return The iterator.
+     */
+    const_iterator end() const { return cells.end(); }
+};
+
+}
+
+#endif // CELLSET_HPP
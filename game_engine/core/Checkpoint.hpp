@@ -0,0 +1,75 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Map.hpp"
+#include "Store.hpp"
+
+namespace hlt {
+
+/** The mutable state of a player, apart from its dropoffs and entities. */
+struct PlayerRecord {
+    Player::id_type id;                     /**< The player ID. */
+    energy_type energy;                     /**< The energy stockpiled by the player. */
+    energy_type factory_energy_deposited;   /**< The energy deposited at the factory so far. */
+    energy_type total_energy_deposited;     /**< The energy collected so far. */
+    bool terminated;                        /**< Whether the player was kicked out of the game. */
+    bool can_play;                          /**< Whether the player has sufficient resources remaining. */
+    size_t dropoffs_end;                    /**< The end of the player's dropoffs in the checkpoint. */
+    size_t entities_end;                    /**< The end of the player's entities in the checkpoint. */
+};
+
+/**
+ * The rules state of a game at one point in time: map, entities, players and turn number.
+ *
+ * Every record is trivially copyable, so taking and restoring a checkpoint copies flat arrays
+ * without per-object work. Checkpoints are immutable and share their state, so copying one
+ * to branch a search is O(1). The replay, statistics and bot connections are not captured.
+ */
+class Checkpoint {
+    friend class Halite;
+
+    /** The checkpointed state. */
+    struct State {
+        unsigned long turn_number{};                 /**< The turn number. */
+
+        std::vector<energy_type> energy;             /**< The energy plane of the map. */
+        std::vector<Entity::id_type> entity;         /**< The entity plane of the map. */
+        std::vector<Player::id_type> owner;          /**< The owner plane of the map. */
+        std::vector<Player::structure_type> structure; /**< The structure plane of the map. */
+
+        std::vector<PlayerRecord> players;           /**< The players, in ID order. */
+        std::vector<Dropoff> dropoffs;               /**< The dropoffs of all players, by player. */
+        /** The entities of all players with their locations, by player. */
+        std::vector<std::pair<Entity::id_type, Location>> player_entities;
+
+        EntityStore entities;                        /**< The entities. */
+        Factory<Entity> entity_factory;              /**< The entity factory. */
+        Factory<Dropoff> dropoff_factory;            /**< The dropoff factory. */
+        ProximityField inspiration_field;            /**< The inspiration field. */
+        std::vector<Location> changed_cells;         /**< The cells changed on the last turn. */
+        unsigned long long map_total_energy{};       /**< The total energy remaining on the map. */
+    };
+
+    static_assert(std::is_trivially_copyable_v<energy_type>, "map planes must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<Entity::id_type>, "map planes must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<Entity>, "entities must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<Dropoff>, "dropoffs must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<PlayerRecord>, "player records must be trivially copyable");
+
+    std::shared_ptr<const State> state; /**< The shared, immutable state. */
+
+public:
+    /**
+     * Get the turn number at which the checkpoint was taken.
+     * @return The turn number.
+     */
+    unsigned long turn_number() const { return state->turn_number; }
+};
+
+}
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,41 @@
+#include <cassert>
+
+#include "EntityStore.hpp"
+
+namespace hlt {
+
+/**
+ * Add an entity. No entity with the same ID may be present.
+ * References to other entities may be invalidated.
+ * @param entity The entity.
+ * @return The stored entity.
+ */
+Entity &EntityStore::insert(const Entity &entity) {
+    assert(entity.id.value >= 0 && slot(entity.id) == NO_SLOT);
+    const auto index = static_cast<size_t>(entity.id.value);
+    if (index >= slots.size()) {
+        slots.resize(std::max(index + 1, 2 * slots.size()), NO_SLOT);
+    }
+    slots[index] = entities.size();
+    entities.push_back(entity);
+    return entities.back();
+}
+
+/**
+ * Remove an entity by ID. The entity must be present.
+ * References to other entities may be invalidated.
+ * @param id The entity ID.
+ */
+void EntityStore::erase(const Entity::id_type &id) {
+    const auto position = slot(id);
+    assert(position != NO_SLOT);
+    // Fill the hole with the last entity.
+    if (position + 1 != entities.size()) {
+        entities[position] = std::move(entities.back());
+        slots[static_cast<size_t>(entities[position].id.value)] = position;
+    }
+    entities.pop_back();
+    slots[static_cast<size_t>(id.value)] = NO_SLOT;
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef ENTITYSTORE_HPP
+#define ENTITYSTORE_HPP
+
+#include <vector>
+
+#include "Entity.hpp"
+
+namespace hlt {
+
+/**
+ * Dense storage for entities with O(1) lookup by ID.
+ *
+ * Entities are kept contiguously for iteration; deleting one moves the last entity into
+ * its place. Entity IDs are handed out in increasing order and never reused, so a table
+ * indexed directly by ID value locates each entity without hashing, and a stale ID simply
+ * finds no entity.
+ */
+class EntityStore {
+public:
+    /** The type of iterators. */
+    using iterator = std::vector<Entity>::iterator;
+    /** The type of const iterators. */
+    using const_iterator = std::vector<Entity>::const_iterator;
+
+private:
+    /** Marker for IDs without a live entity. */
+    static constexpr auto NO_SLOT = static_cast<size_t>(-1);
+
+    std::vector<Entity> entities; /**< The live entities, in no particular order. */
+    std::vector<size_t> slots;    /**< Position in entities by ID value, or NO_SLOT. */
+
+    /**
+     * Get the position of an entity.
+     * @param id The entity ID.
+     * @return The position, or NO_SLOT if there is no such entity.
+     */
+    size_t slot(const Entity::id_type &id) const {
+        const auto index = static_cast<size_t>(id.value);
+        return id.value >= 0 && index < slots.size() ? slots[index] : NO_SLOT;
+    }
+
+public:
+    iterator begin() { return entities.begin(); }
+    iterator end() { return entities.end(); }
+    const_iterator begin() const { return entities.begin(); }
+    const_iterator end() const { return entities.end(); }
+
+    /**
+     * Get the number of live entities.
+     * @return The number of entities.
+     */
+    size_t size() const { return entities.size(); }
+
+    /**
+     * Find an entity by ID.
+     * @param id The entity ID.
+     * @return The entity, or nullptr if there is none.
+     */
+    Entity *find(const Entity::id_type &id) {
+        const auto position = slot(id);
+        return position == NO_SLOT ? nullptr : &entities[position];
+    }
+
+    /**
+     * Find an entity by ID.
+     * @param id The entity ID.
+     * @return The entity, or nullptr if there is none.
+     */
+    const Entity *find(const Entity::id_type &id) const {
+        const auto position = slot(id);
+        return position == NO_SLOT ? nullptr : &entities[position];
+    }
+
+    /**
+     * Add an entity. No entity with the same ID may be present.
+     * References to other entities may be invalidated.
+     * @param entity The entity.
+     * @return The stored entity.
+     */
+    Entity &insert(const Entity &entity);
+
+    /**
+     * Remove an entity by ID. The entity must be present.
+     * References to other entities may be invalidated.
+     * @param id The entity ID.
+     */
+    void erase(const Entity::id_type &id);
+};
+
+}
+
+#endif // ENTITYSTORE_HPP
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <future>
+#include <iterator>
 #include <sstream>
 
 #include "Halite.hpp"
@@ -24,7 +26,9 @@ Halite::Halite(Map &map,
         replay(replay),
         networking(networking_config, *this),
         impl(std::make_unique<HaliteImpl>(*this)),
-        rng(replay.map_generator_seed) {}
+        rng(replay.map_generator_seed) {
+    store.changed_cells.reset(map.width, map.height);
+}
 
 /**
  * Run the game.
@@ -48,9 +52,10 @@ std::string Halite::to_snapshot(const hlt::mapgen::MapParameters &map_parameters
            << SNAPSHOT_LIST_DELIMITER << map_parameters.seed
            << SNAPSHOT_FIELD_DELIMITER;
 
-    for (const auto &row : map.grid) {
-        for (const auto &cell : row) {
-            output << cell.energy << SNAPSHOT_LIST_DELIMITER;
+    for (dimension_type y = 0; y < map.height; y++) {
+        const auto *row = map.energy.row(y);
+        for (dimension_type x = 0; x < map.width; x++) {
+            output << row[x] << SNAPSHOT_LIST_DELIMITER;
         }
     }
     output << SNAPSHOT_FIELD_DELIMITER;
@@ -71,7 +76,7 @@ std::string Halite::to_snapshot(const hlt::mapgen::MapParameters &map_parameters
         output << SNAPSHOT_FIELD_DELIMITER;
 
         for (const auto&[entity_id, entity_location] : player.entities) {
-            const auto &entity = store.entities.at(entity_id);
+            const auto &entity = store.get_entity(entity_id);
             output << entity_id << SNAPSHOT_SUBFIELD_DELIMITER
                    << entity_location.x << SNAPSHOT_SUBFIELD_DELIMITER
                    << entity_location.y << SNAPSHOT_SUBFIELD_DELIMITER
@@ -84,6 +89,85 @@ std::string Halite::to_snapshot(const hlt::mapgen::MapParameters &map_parameters
     return output.str();
 }
 
+/**
+ * Capture the rules state of the game, to return to it later with restore().
+ * @return The checkpoint.
+ */
+Checkpoint Halite::checkpoint() const {
+    auto state = std::make_shared<Checkpoint::State>();
+    state->turn_number = turn_number;
+
+    state->energy = map.energy.grid;
+    state->entity = map.entity.grid;
+    state->owner = map.owner.grid;
+    state->structure = map.structure.grid;
+
+    state->players.reserve(store.players.size());
+    for (const auto &[player_id, player] : store.players) {
+        std::copy(player.dropoffs.begin(), player.dropoffs.end(), std::back_inserter(state->dropoffs));
+        state->player_entities.insert(state->player_entities.end(), player.entities.begin(), player.entities.end());
+        state->players.push_back({player_id, player.energy, player.factory_energy_deposited,
+                                  player.total_energy_deposited, player.terminated, player.can_play,
+                                  state->dropoffs.size(), state->player_entities.size()});
+    }
+
+    state->entities = store.entities;
+    state->entity_factory = store.entity_factory;
+    state->dropoff_factory = store.dropoff_factory;
+    state->inspiration_field = store.inspiration_field;
+    state->changed_cells.assign(store.changed_cells.begin(), store.changed_cells.end());
+    state->map_total_energy = store.map_total_energy;
+
+    Checkpoint checkpoint;
+    checkpoint.state = std::move(state);
+    return checkpoint;
+}
+
+/**
+ * Return the rules state of the game to a checkpoint taken from this game.
+ * Storage is reused, so repeated restores do not allocate.
+ * @param checkpoint The checkpoint.
+ */
+void Halite::restore(const Checkpoint &checkpoint) {
+    const auto &state = *checkpoint.state;
+    assert(state.energy.size() == map.energy.grid.size());
+    assert(state.players.size() == store.players.size());
+    turn_number = state.turn_number;
+
+    map.energy.grid = state.energy;
+    map.entity.grid = state.entity;
+    map.owner.grid = state.owner;
+    map.structure.grid = state.structure;
+
+    auto dropoffs = state.dropoffs.begin();
+    auto entities = state.player_entities.begin();
+    for (const auto &record : state.players) {
+        auto &player = store.get_player(record.id);
+        player.energy = record.energy;
+        player.factory_energy_deposited = record.factory_energy_deposited;
+        player.total_energy_deposited = record.total_energy_deposited;
+        player.terminated = record.terminated;
+        player.can_play = record.can_play;
+
+        // Dropoff locations are const, so dropoffs are copied in rather than assigned.
+        const auto dropoffs_end = state.dropoffs.begin() + record.dropoffs_end;
+        player.dropoffs.clear();
+        std::copy(dropoffs, dropoffs_end, std::back_inserter(player.dropoffs));
+        dropoffs = dropoffs_end;
+
+        const auto entities_end = state.player_entities.begin() + record.entities_end;
+        player.entities.assign(entities, entities_end);
+        entities = entities_end;
+    }
+
+    store.entities = state.entities;
+    store.entity_factory = state.entity_factory;
+    store.dropoff_factory = state.dropoff_factory;
+    store.inspiration_field = state.inspiration_field;
+    store.changed_cells.assign(state.changed_cells.begin(), state.changed_cells.end());
+    store.map_total_energy = state.map_total_energy;
+}
+
 /** Default destructor is defined where HaliteImpl is complete. */
 Halite::~Halite() = default;
 
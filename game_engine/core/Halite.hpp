@@ -1,6 +1,7 @@
 #ifndef HALITE_H
 #define HALITE_H
 
+#include "Checkpoint.hpp"
 #include "Networking.hpp"
 #include "PlayerLog.hpp"
 #include "Store.hpp"
@@ -32,6 +33,8 @@ class Halite final {
 
     friend class HaliteImpl;
 
+    friend class Simulation;
+
     net::Networking networking;       /**< The networking suite. */
     std::unique_ptr<HaliteImpl> impl; /**< The pointer to implementation. */
     std::mt19937 rng;                 /** The random number generator used for tie breaking. */
@@ -63,6 +66,19 @@ public:
     /** Generate a snapshot string from current game state. */
     std::string to_snapshot(const mapgen::MapParameters &map_parameters);
 
+    /**
+     * Capture the rules state of the game, to return to it later with restore().
+     * @return The checkpoint.
+     */
+    Checkpoint checkpoint() const;
+
+    /**
+     * Return the rules state of the game to a checkpoint taken from this game.
+     * Storage is reused, so repeated restores do not allocate.
+     * @param checkpoint The checkpoint.
+     */
+    void restore(const Checkpoint &checkpoint);
+
     /** Default destructor is defined where HaliteImpl is complete. */
     ~Halite();
 };
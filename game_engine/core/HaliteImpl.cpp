@@ -1,4 +1,3 @@
-#include <future>
 #include <set>
 
 #include "HaliteImpl.hpp"
@@ -43,11 +42,7 @@ void HaliteImpl::initialize_game(const std::vector<std::string> &player_commands
         }
     }
 
-    for (dimension_type row = 0; row < game.map.height; row++) {
-        for (dimension_type col = 0; col < game.map.width; col++) {
-            game.store.map_total_energy += game.map.at(col, row).energy;
-        }
-    }
+    game.store.map_total_energy += game.map.total_energy();
 
     for (const auto &command : player_commands) {
         auto &factory = *factory_iterator++;
@@ -60,9 +55,10 @@ void HaliteImpl::initialize_game(const std::vector<std::string> &player_commands
             player.energy = player_snapshot.energy;
 
             for (const auto &[_, dropoff_location] : player_snapshot.dropoffs) {
-                auto &cell = game.map.at(dropoff_location);
+                auto cell = game.map.at(dropoff_location);
                 cell.owner = player.id;
                 player.dropoffs.emplace_back(game.store.new_dropoff(dropoff_location));
+                cell.structure = static_cast<Player::structure_type>(player.dropoffs.size());
                 game.replay.full_frames.back().events.push_back(
                         std::make_unique<ConstructionEvent>(
                                 dropoff_location, player.id, Entity::id_type{0}));
@@ -70,8 +66,9 @@ void HaliteImpl::initialize_game(const std::vector<std::string> &player_commands
             }
 
             for (const auto &entity : player_snapshot.entities) {
-                auto &cell = game.map.at(entity.location);
-                const auto &new_entity = game.store.new_entity(entity.energy, player.id);
+                auto cell = game.map.at(entity.location);
+                auto &new_entity = game.store.new_entity(entity.energy, player.id);
+                new_entity.location = entity.location;
                 cell.entity = new_entity.id;
                 player.add_entity(new_entity.id, entity.location);
                 game.replay.full_frames.back().events.push_back(
@@ -82,13 +79,20 @@ void HaliteImpl::initialize_game(const std::vector<std::string> &player_commands
         players.emplace(player.id, player);
     }
     game.replay.game_statistics = game.game_statistics;
+    standard_rules = StandardRules::matches(constants);
+    Logging::log(standard_rules ? "Using the standard rules" : "Using the rules of the constants file",
+                 Logging::Level::Debug);
+    if (constants.INSPIRATION_ENABLED) {
+        game.store.reset_inspiration_field(game.map.width, game.map.height, constants.INSPIRATION_RADIUS);
+    }
 
     for (auto &[player_id, player] : game.store.players) {
         // Zero the energy on factory and mark as owned.
-        auto &factory = game.map.at(player.factory);
+        auto factory = game.map.at(player.factory);
         game.store.map_total_energy -= factory.energy;
         factory.energy = 0;
         factory.owner = player_id;
+        factory.structure = Player::FACTORY;
         // Prepare the log.
         game.logs.add(player_id);
     }
@@ -101,7 +105,6 @@ void HaliteImpl::initialize_game(const std::vector<std::string> &player_commands
 void HaliteImpl::run_game() {
     const auto &constants = Constants::get();
 
-    ordered_id_map<Player, std::future<void>> results{};
     bool success = true;
     for (auto &[player_id, player] : game.store.players) {
         Logging::log("Launching with command " + player.command, Logging::Level::Info, player.id);
@@ -120,17 +123,16 @@ void HaliteImpl::run_game() {
         return;
     }
 
+    // Every bot is sent its init before any reply is awaited, so that bots start up concurrently
+    const auto init = game.networking.encode_init();
     for (auto &[player_id, player] : game.store.players) {
         Logging::log("Initializing player", Logging::Level::Info, player_id);
-        results[player_id] = std::async(std::launch::async,
-                                        [&networking = game.networking, &player = player] {
-                                            networking.initialize_player(player);
-                                        });
+        game.networking.send_init(player, init);
     }
-    for (auto &[player_id, result] : results) {
+    for (auto &[player_id, player] : game.store.players) {
         try {
-            result.get();
-            Logging::log("Initialized player " + game.store.get_player(player_id).name, Logging::Level::Info, player_id);
+            game.networking.receive_name(player);
+            Logging::log("Initialized player " + player.name, Logging::Level::Info, player_id);
         } catch (const BotError &e) {
             kill_player(player_id);
         }
@@ -138,33 +140,58 @@ void HaliteImpl::run_game() {
     game.replay.players.insert(game.store.players.begin(), game.store.players.end());
     Logging::log("Player initialization complete");
 
+    using namespace std::chrono;
     for (game.turn_number = 1; game.turn_number <= constants.MAX_TURNS; game.turn_number++) {
-        Logging::set_turn_number(game.turn_number);
-        game.logs.set_turn_number(game.turn_number);
-        // Used to track the current turn number inside Event::update_stats
-        game.game_statistics.turn_number = game.turn_number;
-        Logging::log([turn_number = game.turn_number]() {
-            return "Starting turn " + std::to_string(turn_number);
-        }, Logging::Level::Debug);
-        // Create new turn struct for replay file, to be filled by further turn actions
-        game.replay.full_frames.emplace_back();
-
-        // Add state of entities at start of turn.
-        // First, update inspiration flags, so they can be used for
-        // movement/mining and so they are part of the replay.
-        update_inspiration();
-        game.replay.full_frames.back().add_entities(game.store);
-
+        const auto turn_start = high_resolution_clock::now();
+        start_turn();
         process_turn();
-
-        // Add end of frame state.
-        game.replay.full_frames.back().add_end_state(game.store);
-
-        if (game_ended()) {
+        const auto ended = end_turn();
+        const auto engine_time = high_resolution_clock::now() - turn_start - bot_wait;
+        game.game_statistics.turn_engine_times.push_back(duration_cast<microseconds>(engine_time).count());
+        if (ended) {
             game.turn_number++;
             break;
         }
     }
+    end_game();
+    for (const auto &[player_id, player] : game.store.players) {
+        if (!player.terminated) {
+            game.networking.kill_player(player);
+        }
+    }
+}
+
+/** Begin the current turn, before commands are processed. */
+void HaliteImpl::start_turn() {
+    Logging::set_turn_number(game.turn_number);
+    game.logs.set_turn_number(game.turn_number);
+    // Used to track the current turn number inside Event::update_stats
+    game.game_statistics.turn_number = game.turn_number;
+    Logging::log([turn_number = game.turn_number]() {
+        return "Starting turn " + std::to_string(turn_number);
+    }, Logging::Level::Debug);
+    // Create new turn struct for replay file, to be filled by further turn actions
+    game.replay.full_frames.emplace_back();
+
+    // Add state of entities at start of turn.
+    // First, update inspiration flags, so they can be used for
+    // movement/mining and so they are part of the replay.
+    update_inspiration();
+    game.replay.full_frames.back().add_entities(game.store);
+}
+
+/**
+ * Finish the current turn, after commands are processed.
+ * @return True if the game has ended.
+ */
+bool HaliteImpl::end_turn() {
+    // Add end of frame state.
+    game.replay.full_frames.back().add_end_state(game.store);
+    return game_ended();
+}
+
+/** Record the end of the game, after the last turn. */
+void HaliteImpl::end_game() {
     game.game_statistics.number_turns = game.turn_number;
 
     // Add state of entities at end of game.
@@ -180,117 +207,71 @@ void HaliteImpl::run_game() {
     game.logs.set_turn_number(PlayerLog::ended);
     for (const auto &[player_id, player] : game.store.players) {
         game.replay.players.find(player_id)->second.terminated = player.terminated;
-        if (!player.terminated) {
-            game.networking.kill_player(player);
-        }
     }
 }
 
 /** Retrieve and process commands, and update the game state for the current turn. */
 void HaliteImpl::process_turn() {
-    // Retrieve all commands
-    using Commands = std::vector<std::unique_ptr<Command>>;
-    ordered_id_map<Player, Commands> commands{};
-    id_map<Player, std::future<Commands>> results{};
-    for (auto &[player_id, player] : game.store.players) {
+    retrieve_commands();
+    process_commands();
+}
+
+/** Retrieve the commands of the current turn from the players. */
+void HaliteImpl::retrieve_commands() {
+    commands.clear();
+    // The frame is the same for every player using a protocol, so it is encoded once and shared.
+    // It is sent to every bot before any reply is awaited, and the reactor completes the exchanges,
+    // so bots think concurrently with no thread waiting on each.
+    const auto frame = game.networking.encode_frame();
+    for (const auto &[player_id, player] : game.store.players) {
         if (!player.terminated) {
-            results[player_id] = std::async(std::launch::async,
-                                            [&networking = game.networking, &player = player] {
-                                                return networking.handle_frame(player);
-                                            });
+            game.networking.send_frame(player, frame);
         }
     }
-    for (auto &[player_id, result] : results) {
+    const auto wait_start = std::chrono::high_resolution_clock::now();
+    for (auto &[player_id, player] : game.store.players) {
+        if (player.terminated) {
+            continue;
+        }
         try {
-            commands[player_id] = result.get();
+            commands[player_id] = game.networking.receive_commands(player);
         } catch (const BotError &e) {
             kill_player(player_id);
             commands.erase(player_id);
         }
     }
+    bot_wait = std::chrono::high_resolution_clock::now() - wait_start;
+}
 
-    // Process valid player commands, removing players if they submit invalid ones.
-    std::unordered_set<Entity::id_type> changed_entities;
-    while (!commands.empty()) {
-        changed_entities.clear();
-        game.store.changed_cells.clear();
-
-        CommandTransaction transaction{game.store, game.map};
-        std::unordered_set<Player::id_type> offenders;
-        transaction.on_event([&frames = game.replay.full_frames, this](GameEvent event) {
-            event->update_stats(game.store, game.map, game.game_statistics);
-            // Create new game event for replay file.
-            frames.back().events.push_back(std::move(event));
-        });
-        transaction.on_error([&offenders, &commands, this](CommandError error) {
-            this->handle_error(offenders, commands, std::move(error));
-        });
-        transaction.on_cell_update([&changed_cells = game.store.changed_cells](Location cell) {
-            changed_cells.emplace(cell);
-        });
-        transaction.on_entity_update([&changed_entities](Entity::id_type entity) {
-            changed_entities.emplace(entity);
-        });
-
-        for (const auto &[player_id, command_list] : commands) {
-            auto &player = game.store.players.find(player_id)->second;
-            for (const auto &command : command_list) {
-                command->add_to_transaction(player, transaction);
-            }
-        }
-        if (transaction.check()) {
-            // All commands are successful.
-            transaction.commit();
-            if (Constants::get().STRICT_ERRORS) {
-                if (!offenders.empty()) {
-                    std::ostringstream stream;
-                    stream << "Command processing failed for players: ";
-                    for (auto iterator = offenders.begin(); iterator != offenders.end(); iterator++) {
-                        stream << *iterator;
-                        if (std::next(iterator) != offenders.end()) {
-                            stream << ", ";
-                        }
-                    }
-                    stream << ", aborting due to strict error check";
-                    Logging::log(stream.str(), Logging::Level::Error);
-                    game.turn_number = Constants::get().MAX_TURNS;
-                    return;
-                }
-            } else {
-                assert(offenders.empty());
-            }
-            // Add player commands to replay and note players still alive
-            game.replay.full_frames.back().moves = std::move(commands);
-            break;
-        } else {
-            for (auto player : offenders) {
-                kill_player(player);
-                commands.erase(player);
-            }
-        }
-    }
-
+/**
+ * Resolve ship mining and capture after the commands of the current turn.
+ * @tparam Rules The rules policy.
+ * @param rules The rule parameters.
+ */
+template<class Rules>
+void HaliteImpl::resolve_ships(const Rules &rules) {
     // Resolve ship mining
-    const auto max_energy = Constants::get().MAX_ENERGY;
-    const auto ships_threshold = Constants::get().SHIPS_ABOVE_FOR_CAPTURE;
-    const auto bonus_multiplier = Constants::get().INSPIRED_BONUS_MULTIPLIER;
-    for (auto &[entity_id, entity] : game.store.entities) {
-        if (changed_entities.find(entity_id) == changed_entities.end()
+    const auto max_energy = rules.MAX_ENERGY;
+    const auto ships_threshold = rules.SHIPS_ABOVE_FOR_CAPTURE;
+    const auto bonus_multiplier = rules.INSPIRED_BONUS_MULTIPLIER;
+    for (auto &entity : game.store.entities) {
+        if (changed_entities.find(entity.id) == changed_entities.end()
             && entity.energy < max_energy) {
             // Allow this entity to extract
-            const auto location = game.store.get_player(entity.owner).get_entity_location(entity_id);
-            auto &cell = game.map.at(location);
-
-            const auto ratio = entity.is_inspired ?
-                Constants::get().INSPIRED_EXTRACT_RATIO :
-                Constants::get().EXTRACT_RATIO;
-            energy_type extracted = static_cast<energy_type>(
-                std::ceil(static_cast<double>(cell.energy) / ratio));
+            const auto location = entity.location;
+            // Only the energy of the cell is needed here.
+            auto &cell_energy = game.map.energy.at(location);
+
+            const auto ratio = static_cast<energy_type>(entity.is_inspired ?
+                rules.INSPIRED_EXTRACT_RATIO :
+                rules.EXTRACT_RATIO);
+            // Integer ceiling division, exact where the quotient in double precision is.
+            energy_type extracted = (cell_energy + ratio - 1) / ratio;
             energy_type gained = extracted;
 
             // If energy is small, give it all to the entity.
-            if (extracted == 0 && cell.energy > 0) {
-                extracted = gained = cell.energy;
+            if (extracted == 0 && cell_energy > 0) {
+                extracted = gained = cell_energy;
             }
 
             // Don't take more than the entity can hold.
@@ -314,54 +295,45 @@ void HaliteImpl::process_turn() {
                 player_stats.total_mined_from_captured += gained;
             }
             entity.energy += gained;
-            cell.energy -= extracted;
+            cell_energy -= extracted;
             game.store.map_total_energy -= extracted;
-            game.store.changed_cells.emplace(location);
+            game.store.changed_cells.insert(location);
         }
     }
 
     // Resolve ship capture
-    if (Constants::get().CAPTURE_ENABLED) {
-        const auto capture_radius = Constants::get().CAPTURE_RADIUS;
-        std::unordered_map<Location, Player::id_type> entity_switches;
+    if (rules.CAPTURE_ENABLED) {
+        const auto capture_radius = rules.CAPTURE_RADIUS;
+        // Count the ships of every player within the capture radius of every cell at once.
+        capture_field.reset(game.map.width, game.map.height, game.store.players.size(), capture_radius);
         for (const auto &[player_id, player] : game.store.players) {
             for (const auto &[entity_id, location] : player.entities) {
-                id_map<Player, unsigned long> ships_in_radius;
-                for(const auto &[pid, _] : game.store.players) ships_in_radius[pid] = 0;
-
-                std::unordered_set<Location> visited_locs{};
-                std::unordered_set<Location> to_visit_locs{location};
-                while(!to_visit_locs.empty()) {
-                    const Location cur = *to_visit_locs.begin();
-                    visited_locs.emplace(cur);
-                    to_visit_locs.erase(to_visit_locs.begin());
-
-                    Cell cur_cell = game.map.at(cur);
-                    if(cur_cell.entity != Entity::None) {
-                        ships_in_radius[game.store.get_entity(cur_cell.entity).owner]++;
-                    }
-
-                    for(const Location &neighbor : game.map.get_neighbors(cur)) {
-                        if((visited_locs.find(neighbor) == visited_locs.end())
-                           && (to_visit_locs.find(neighbor) == to_visit_locs.end())) {
-                            if(game.map.distance(location, neighbor) <= capture_radius) {
-                                to_visit_locs.emplace(neighbor);
-                            } else {
-                                visited_locs.emplace(neighbor);
-                            }
-                        }
-                    }
-                }
+                capture_field.add(static_cast<size_t>(player_id.value), location);
+            }
+        }
+        capture_field.compute();
+
+        // Ties between opponents are broken by the iteration order of an id_map over the players.
+        std::vector<Player::id_type> tie_break_order;
+        {
+            id_map<Player, unsigned long> ships_in_radius;
+            for (const auto &[pid, _] : game.store.players) ships_in_radius[pid] = 0;
+            for (const auto &[pid, _] : ships_in_radius) tie_break_order.push_back(pid);
+        }
 
+        std::unordered_map<Location, Player::id_type> entity_switches;
+        for (const auto &[player_id, player] : game.store.players) {
+            for (const auto &[entity_id, location] : player.entities) {
                 unsigned long max_val = 0;
                 Player::id_type max_id = Player::None;
-                for(const auto &[pid, val] : ships_in_radius) {
-                    if(pid != player_id && val > max_val) {
+                for (const auto &pid : tie_break_order) {
+                    const auto val = capture_field.count(static_cast<size_t>(pid.value), location);
+                    if (pid != player_id && val > max_val) {
                         max_val = val;
                         max_id = pid;
                     }
                 }
-                if(ships_in_radius[player_id]+ships_threshold <= max_val) {
+                if (capture_field.count(static_cast<size_t>(player_id.value), location) + ships_threshold <= max_val) {
                     entity_switches[location] = max_id;
                 }
             }
@@ -369,76 +341,106 @@ void HaliteImpl::process_turn() {
 
         // Flip the ships that have been captured
         for(const auto &[location, new_player_id] : entity_switches) {
-            auto &cell = game.map.at(location);
+            auto cell = game.map.at(location);
             const auto entity = game.store.get_entity(cell.entity);
 
             game.game_statistics.player_statistics.at(entity.owner.value).ships_given++;
             game.game_statistics.player_statistics.at(new_player_id.value).ships_captured++;
 
             game.store.delete_entity(entity.id);
-            auto &entities = game.store.get_player(entity.owner).entities;
-            entities.erase(entities.find(entity.id));
+            game.store.lift_entity(game.store.get_player(entity.owner), entity.id);
 
             auto new_entity = game.store.new_entity(entity.energy, new_player_id);
             // XXX new_entity seems to be a copy not a real reference
             cell.entity = new_entity.id;
             game.store.get_entity(new_entity.id).was_captured = true;
-            game.store.get_player(new_player_id).add_entity(new_entity.id, location);
+            game.store.place_entity(game.store.get_player(new_player_id), new_entity.id, location);
 
             game.replay.full_frames.back().events.push_back(
                                                             std::make_unique<CaptureEvent>(location, entity.owner, entity.id,
                                                                                            new_player_id, new_entity.id));
         }
     }
+}
 
+/** Process the commands of the current turn, and update the game state. */
+void HaliteImpl::process_commands() {
+    // Process valid player commands, removing players if they submit invalid ones.
+    changed_entities.clear();
+    if (!commands.empty()) {
+        game.store.changed_cells.clear();
+
+        transaction.reset();
+        offenders.clear();
+
+        for (const auto &[player_id, command_list] : commands) {
+            auto &player = game.store.players.find(player_id)->second;
+            for (const auto &command : command_list) {
+                // Invoke overload resolution on CommandTransaction::add_command
+                std::visit([&](const auto &alternative) { transaction.add_command(player, alternative); }, command);
+            }
+        }
+        if (!transaction.check()) {
+            // Validation is partitioned by player, so the commands of the remaining players
+            // stay valid once the offenders are removed, and need not be checked again.
+            for (auto player : offenders) {
+                transaction.remove_player(game.store.get_player(player));
+                kill_player(player);
+                commands.erase(player);
+            }
+            offenders.clear();
+        }
+    }
+    if (!commands.empty()) {
+        // All remaining commands are successful.
+        transaction.commit();
+        if (Constants::get().STRICT_ERRORS) {
+            if (!offenders.empty()) {
+                std::ostringstream stream;
+                stream << "Command processing failed for players: ";
+                for (auto iterator = offenders.begin(); iterator != offenders.end(); iterator++) {
+                    stream << *iterator;
+                    if (std::next(iterator) != offenders.end()) {
+                        stream << ", ";
+                    }
+                }
+                stream << ", aborting due to strict error check";
+                Logging::log(stream.str(), Logging::Level::Error);
+                game.turn_number = Constants::get().MAX_TURNS;
+                return;
+            }
+        } else {
+            assert(offenders.empty());
+        }
+        // Add player commands to replay and note players still alive
+        game.replay.full_frames.back().moves = std::move(commands);
+    }
 
+    with_rules([this](const auto &rules) { resolve_ships(rules); });
     game.replay.full_frames.back().add_cells(game.map, game.store.changed_cells);
     update_player_stats();
 }
 
-void HaliteImpl::update_inspiration() {
-    if (!Constants::get().INSPIRATION_ENABLED) {
+/**
+ * Update the inspiration flag on entities based on the current game state.
+ * @tparam Rules The rules policy.
+ * @param rules The rule parameters.
+ */
+template<class Rules>
+void HaliteImpl::update_inspiration(const Rules &rules) {
+    if (!rules.INSPIRATION_ENABLED) {
         return;
     }
 
-    const auto inspiration_radius = Constants::get().INSPIRATION_RADIUS;
-    const auto ships_threshold = Constants::get().INSPIRATION_SHIP_COUNT;
+    const auto ships_threshold = rules.INSPIRATION_SHIP_COUNT;
 
-    // Check every ship of every player
+    // Ship counts within the radius are kept up to date by the store as ships come and go.
+    const auto &field = game.store.inspiration_field;
     for (const auto &[player_id, player] : game.store.players) {
         for (const auto &[entity_id, location] : player.entities) {
-            // map from player ID to # of ships within the inspiration
-            // radius of the current ship
-            id_map<Player, long> ships_in_radius;
-            for (const auto &[pid, _] : game.store.players) {
-                ships_in_radius[pid] = 0;
-            }
-
-            // Explore locations around this ship
-            for (auto dx = -inspiration_radius; dx <= inspiration_radius; dx++) {
-                for (auto dy = -inspiration_radius; dy <= inspiration_radius; dy++) {
-                    const auto cur = Location{
-                        (((location.x + dx) % game.map.width) + game.map.width) % game.map.width,
-                        (((location.y + dy) % game.map.height) + game.map.height) % game.map.height
-                    };
-
-                    const auto &cur_cell = game.map.at(cur);
-                    if (cur_cell.entity == Entity::None ||
-                        game.map.distance(location, cur) > inspiration_radius) {
-                        continue;
-                    }
-                    const auto &other_entity = game.store.get_entity(cur_cell.entity);
-                    ships_in_radius[other_entity.owner]++;
-                }
-            }
-
-            // Total up ships of other player
-            unsigned long opponent_entities = 0;
-            for (const auto &[pid, count] : ships_in_radius) {
-                if (pid != player_id) {
-                    opponent_entities += count;
-                }
-            }
+            // Total up ships of other players
+            const auto opponent_entities = static_cast<unsigned long>(
+                    field.total(location) - field.count(static_cast<size_t>(player_id.value), location));
 
             // Mark ship as inspired or not
             auto &entity = game.store.get_entity(entity_id);
@@ -447,6 +449,10 @@ void HaliteImpl::update_inspiration() {
     }
 }
 
+void HaliteImpl::update_inspiration() {
+    with_rules([this](const auto &rules) { update_inspiration(rules); });
+}
+
 /**
  * Determine whether a player can still play in the future
  *
@@ -466,7 +472,7 @@ bool HaliteImpl::game_ended() const {
         return std::all_of(all_entities.begin(),
                            all_entities.end(),
                            [](const auto& entity) {
-                               return entity.second.energy == 0;
+                               return entity.energy == 0;
                            });
     }
     long num_alive_players = 0;
@@ -496,6 +502,7 @@ bool HaliteImpl::game_ended() const {
  * Update all players' statistics after a single turn.
  */
 void HaliteImpl::update_player_stats() {
+    update_interaction_field();
     for (PlayerStatistics &player_stats : game.game_statistics.player_statistics) {
         // Player with sprites is still alive, so mark as alive on this turn and add production gained
         const auto &player_id = player_stats.player_id;
@@ -520,7 +527,7 @@ void HaliteImpl::update_player_stats() {
                     player_stats.max_entity_distance = entity_distance;
                 player_stats.total_distance += entity_distance;
                 player_stats.total_entity_lifespan++;
-                if (possible_interaction(player_id, location)) {
+                if (interaction_field.other_present(static_cast<size_t>(player_id.value), location)) {
                     player_stats.interaction_opportunities++;
                 }
             }
@@ -538,32 +545,25 @@ void HaliteImpl::update_player_stats() {
 }
 
 /**
- * Determine if entity owned by given player is in range of another player (their entity, dropoff, or factory) and thus may interact
- *
- * param owner_id Id of owner of entity at given location
- * param entity_location Location of entity we are assessing for an interaction opportunity
- * return bool Indicator of whether there players are in close range for an interaction (true) or not (false)
+ * Rebuild the interaction field from the entities, factories and dropoffs on the map, so that
+ * whether an entity is in range of another player (and thus may interact) is an O(1) lookup.
  */
-bool HaliteImpl::possible_interaction(const Player::id_type owner_id, const Location entity_location) {
-    // Fetch all locations 2 cells away
-    std::unordered_set<Location> close_cells{};
-    const auto neighbors = game.map.get_neighbors(entity_location);
-    close_cells.insert(neighbors.begin(), neighbors.end());
-    for (const Location &neighbor : neighbors) {
-        const auto cells_once_removed = game.map.get_neighbors(neighbor);
-        close_cells.insert(cells_once_removed.begin(), cells_once_removed.end());
-    }
-    // Interaction possibilty implies a cell has an entity owned by another player or there is a factory or dropoff
-    // of another player on the cell. Interactions between entities of a single player are ignored
-    for (const Location &cell_location : close_cells) {
-        const Cell &cell = game.map.at(cell_location);
-        if (cell.entity != Entity::None) {
-            if (game.store.get_entity(cell.entity).owner != owner_id) return true;
+void HaliteImpl::update_interaction_field() {
+    // Interactions are possible with entities, factories and dropoffs of other players up to 2 cells away
+    static constexpr dimension_type INTERACTION_RADIUS = 2;
+    interaction_field.reset(game.map.width, game.map.height, game.store.players.size(), INTERACTION_RADIUS);
+    for (dimension_type y = 0; y < game.map.height; y++) {
+        for (dimension_type x = 0; x < game.map.width; x++) {
+            const auto cell = game.map.at(x, y);
+            if (cell.entity != Entity::None) {
+                interaction_field.add(static_cast<size_t>(game.store.get_entity(cell.entity).owner.value), {x, y});
+            }
+            if (cell.owner != Player::None) {
+                interaction_field.add(static_cast<size_t>(cell.owner.value), {x, y});
+            }
         }
-        if (cell.owner != Player::None && cell.owner != owner_id) return true;
     }
-    return false;
-
+    interaction_field.compute();
 }
 
 /**
@@ -595,13 +595,11 @@ void HaliteImpl::kill_player(const Player::id_type &player_id) {
     player.can_play = false;
     game.networking.kill_player(player);
 
-    auto &entities = player.entities;
-    for (auto entity_iterator = entities.begin();
-         entity_iterator != entities.end();
-         entity_iterator = entities.erase(entity_iterator)) {
-        const auto &[entity_id, location] = *entity_iterator;
-        auto &cell = game.map.at(location);
+    while (!player.entities.empty()) {
+        const auto [entity_id, location] = *player.entities.begin();
+        auto cell = game.map.at(location);
         cell.entity = Entity::None;
+        game.store.lift_entity(player, entity_id);
         game.store.delete_entity(entity_id);
     }
     player.energy = 0;
@@ -611,7 +609,23 @@ void HaliteImpl::kill_player(const Player::id_type &player_id) {
  * Construct HaliteImpl from game interface.
  * @param game The game interface.
  */
-HaliteImpl::HaliteImpl(Halite &game) : game(game) {}
+HaliteImpl::HaliteImpl(Halite &game) : game(game), transaction(game.store, game.map) {
+    // The callbacks are set once, and find the state of the current turn in members.
+    transaction.on_event([this](GameEvent event) {
+        event->update_stats(this->game.store, this->game.map, this->game.game_statistics);
+        // Create new game event for replay file.
+        this->game.replay.full_frames.back().events.push_back(std::move(event));
+    });
+    transaction.on_error([this](CommandError error) {
+        handle_error(offenders, commands, std::move(error));
+    });
+    transaction.on_cell_update([this](Location cell) {
+        this->game.store.changed_cells.insert(cell);
+    });
+    transaction.on_entity_update([this](Entity::id_type entity) {
+        changed_entities.emplace(entity);
+    });
+}
 
 /**
  * Handle a player command error.
@@ -620,7 +634,7 @@ HaliteImpl::HaliteImpl(Halite &game) : game(game) {}
  * @param error The error caused by the player.
  */
 void HaliteImpl::handle_error(std::unordered_set<Player::id_type> &offenders,
-                              ordered_id_map<Player, std::vector<std::unique_ptr<Command>>> &commands,
+                              ordered_id_map<Player, std::vector<Command>> &commands,
                               CommandError error) {
     const auto message = error->log_message();
     const auto &faulty = error->command();
@@ -638,9 +652,10 @@ void HaliteImpl::handle_error(std::unordered_set<Player::id_type> &offenders,
 
     // Find the position of a command within a player's command list.
     auto &player_commands = commands[player_id];
-    const auto find_position = [&player_commands](const Command &faulty) {
+    const auto find_position = [&player_commands](const BaseCommand &faulty) {
         return std::find_if(player_commands.begin(), player_commands.end(), [&faulty](const auto &command) {
-            return std::addressof(*command) == std::addressof(faulty);
+            const auto address = std::visit([](const BaseCommand &alternative) { return &alternative; }, command);
+            return address == std::addressof(faulty);
         });
     };
 
@@ -655,7 +670,7 @@ void HaliteImpl::handle_error(std::unordered_set<Player::id_type> &offenders,
         for (auto iterator = commands_begin; iterator != commands_end; iterator++) {
             auto number = std::distance(player_commands.begin(), iterator);
             auto marker = iterator == position ? ">>> " : "    ";
-            game.logs.log(player_id, marker + std::to_string(number + 1) + "   " + (*iterator)->to_bot_serial());
+            game.logs.log(player_id, marker + std::to_string(number + 1) + "   " + to_bot_serial(*iterator));
         }
         game.logs.log(player_id, "");
     };
@@ -1,11 +1,17 @@
 #ifndef HALITEIMPL_HPP
 #define HALITEIMPL_HPP
 
+#include <chrono>
 #include <queue>
 
 #include "CommandTransaction.hpp"
+#include "Constants.hpp"
 #include "Halite.hpp"
+#include "Logging.hpp"
+#include "OccupancyField.hpp"
+#include "PresenceField.hpp"
 #include "Replay.hpp"
+#include "Rules.hpp"
 #include "Snapshot.hpp"
 #include "BotError.hpp"
 
@@ -14,10 +20,46 @@ namespace hlt {
 /** Halite implementation class, expressing core game logic. */
 class HaliteImpl final {
     friend class Halite;
+    friend class Simulation;
 
     /** The game interface. */
     Halite &game;
 
+    /** Ship counts per player around every cell, used to resolve capture. */
+    OccupancyField capture_field;
+
+    /** Presence of each player around every cell, used to count interaction opportunities. */
+    PresenceField interaction_field;
+
+    /** The command transaction, reused from turn to turn. */
+    CommandTransaction transaction;
+    /** The commands of the current turn. */
+    ordered_id_map<Player, std::vector<Command>> commands;
+    /** The players who caused errors in the current command transaction. */
+    std::unordered_set<Player::id_type> offenders;
+    /** The entities updated by the current command transaction. */
+    std::unordered_set<Entity::id_type> changed_entities;
+
+    /** Whether the constants follow the standard ruleset, selecting the StandardRules policy. */
+    bool standard_rules{};
+
+    /** The time the current turn spent waiting for the bots to reply. */
+    std::chrono::high_resolution_clock::duration bot_wait{};
+
+    /**
+     * Call a function with the rules policy selected for this game.
+     * @tparam Function The type of the function.
+     * @param function The function, taking the rules policy.
+     */
+    template<class Function>
+    void with_rules(Function &&function) {
+        if (standard_rules) {
+            function(StandardRules{});
+        } else {
+            function(RuntimeRules(Constants::get()));
+        }
+    }
+
     /**
      * Initialize the game.
      * @param player_commands The list of player commands.
@@ -52,13 +94,10 @@ class HaliteImpl final {
     void update_player_stats();
 
     /**
-     * Determine if entity owned by given player is in range of another player (their entity, dropoff, or factory) and thus may interact
-     *
-     * param owner_id Id of owner of entity at given location
-     * param entity_location Location of entity we are assessing for an interaction opportunity
-     * return bool Indicator of whether there players are in close range for an interaction (true) or not (false)
+     * Rebuild the interaction field from the entities, factories and dropoffs on the map, so that
+     * whether an entity is in range of another player (and thus may interact) is an O(1) lookup.
      */
-    bool possible_interaction(const Player::id_type owner_id, const Location entity_location);
+    void update_interaction_field();
 
     /**
      * Update players' rankings based on their final turn alive, then break ties with production totals in final turn.
@@ -70,9 +109,43 @@ class HaliteImpl final {
     /** Update the inspiration flag on entities based on the current game state. */
     void update_inspiration();
 
+    /**
+     * Update the inspiration flag on entities based on the current game state.
+     * @tparam Rules The rules policy.
+     * @param rules The rule parameters.
+     */
+    template<class Rules>
+    void update_inspiration(const Rules &rules);
+
+    /**
+     * Resolve ship mining and capture after the commands of the current turn.
+     * @tparam Rules The rules policy.
+     * @param rules The rule parameters.
+     */
+    template<class Rules>
+    void resolve_ships(const Rules &rules);
+
+    /** Begin the current turn, before commands are processed. */
+    void start_turn();
+
     /** Retrieve and process commands, and update the game state for the current turn. */
     void process_turn();
 
+    /** Retrieve the commands of the current turn from the players. */
+    void retrieve_commands();
+
+    /** Process the commands of the current turn, and update the game state. */
+    void process_commands();
+
+    /**
+     * Finish the current turn, after commands are processed.
+     * @return True if the game has ended.
+     */
+    bool end_turn();
+
+    /** Record the end of the game, after the last turn. */
+    void end_game();
+
     /** Remove a player from the game. */
     void kill_player(const Player::id_type &player_id);
 
@@ -83,7 +156,7 @@ class HaliteImpl final {
      * @param error The error caused by the player.
      */
     void handle_error(std::unordered_set<Player::id_type> &offenders,
-                      ordered_id_map<Player, std::vector<std::unique_ptr<Command>>> &commands,
+                      ordered_id_map<Player, std::vector<Command>> &commands,
                       CommandError error);
 
 public:
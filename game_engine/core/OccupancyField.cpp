@@ -0,0 +1,161 @@
+#include <algorithm>
+
+#include "OccupancyField.hpp"
+
+namespace hlt {
+
+/**
+ * Clear the field and prepare it for a new set of occupants.
+ * Storage is reused across calls with the same dimensions.
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @param layers The number of layers.
+ * @param radius The Manhattan radius to count within.
+ */
+void OccupancyField::reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius) {
+    this->width = width;
+    this->height = height;
+    this->layers = layers;
+    // A cell is always within range of itself, even for a negative radius.
+    this->radius = std::max(radius, dimension_type{0});
+    const auto plane_size = static_cast<size_t>(width * height);
+    occupancy.assign(layers * plane_size, 0);
+    counts.resize(layers * plane_size);
+}
+
+/** Compute the counts within the radius for every layer and cell. */
+void OccupancyField::compute() {
+    // The sliding window assumes that no two offsets in the diamond wrap onto the same cell.
+    const auto diameter = 2 * radius + 1;
+    const bool can_slide = diameter <= width && diameter <= height;
+    for (size_t layer = 0; layer < layers; layer++) {
+        if (can_slide) {
+            compute_sliding(layer);
+        } else {
+            compute_direct(layer);
+        }
+    }
+}
+
+/**
+ * Compute the counts of a single layer using diagonal prefix sums.
+ * Requires that the diamond of the radius does not wrap onto itself.
+ *
+ * The plane is padded by the radius on every side so that no diamond wraps. Moving a diamond
+ * one cell east adds its east edge and removes the west edge of the previous diamond; each
+ * edge is two diagonal segments, which are summed in O(1) from the diagonal prefix sums.
+ *
+ * @param layer The layer.
+ */
+void OccupancyField::compute_sliding(size_t layer) {
+    const auto padded_width = width + 2 * radius;
+    const auto padded_height = height + 2 * radius;
+    const auto padded_size = static_cast<size_t>(padded_width * padded_height);
+    padded.resize(padded_size);
+    down_right.resize(padded_size);
+    down_left.resize(padded_size);
+
+    const auto plane_offset = layer * static_cast<size_t>(width * height);
+    const auto *plane = occupancy.data() + plane_offset;
+    auto *result = counts.data() + plane_offset;
+
+    const auto index = [padded_width](dimension_type row, dimension_type col) {
+        return static_cast<size_t>(row * padded_width + col);
+    };
+
+    for (dimension_type row = 0; row < padded_height; row++) {
+        const auto source_row = ((row - radius) % height + height) % height;
+        for (dimension_type col = 0; col < padded_width; col++) {
+            const auto source_col = ((col - radius) % width + width) % width;
+            padded[index(row, col)] = plane[source_row * width + source_col];
+        }
+    }
+    for (dimension_type row = 0; row < padded_height; row++) {
+        for (dimension_type col = 0; col < padded_width; col++) {
+            const auto value = padded[index(row, col)];
+            const auto has_previous_row = row > 0;
+            down_right[index(row, col)] = value +
+                (has_previous_row && col > 0 ? down_right[index(row - 1, col - 1)] : 0);
+            down_left[index(row, col)] = value +
+                (has_previous_row && col + 1 < padded_width ? down_left[index(row - 1, col + 1)] : 0);
+        }
+    }
+
+    // Sum of a down-right diagonal segment from (top_row, top_col) to (bottom_row, bottom_col).
+    const auto sum_down_right = [&](dimension_type top_row, dimension_type top_col,
+                                    dimension_type bottom_row, dimension_type bottom_col) {
+        const count_type before = top_row > 0 && top_col > 0 ? down_right[index(top_row - 1, top_col - 1)] : 0;
+        return down_right[index(bottom_row, bottom_col)] - before;
+    };
+    // Sum of a down-left diagonal segment from (top_row, top_col) to (bottom_row, bottom_col).
+    const auto sum_down_left = [&](dimension_type top_row, dimension_type top_col,
+                                   dimension_type bottom_row, dimension_type bottom_col) {
+        const count_type before = top_row > 0 && top_col + 1 < padded_width
+                                  ? down_left[index(top_row - 1, top_col + 1)] : 0;
+        return down_left[index(bottom_row, bottom_col)] - before;
+    };
+
+    for (dimension_type y = 0; y < height; y++) {
+        // Centers are addressed in padded coordinates from here on.
+        const auto center_row = y + radius;
+
+        // Sum the first diamond of the row directly.
+        count_type sum = 0;
+        for (auto dy = -radius; dy <= radius; dy++) {
+            const auto span = radius - std::abs(dy);
+            for (auto dx = -span; dx <= span; dx++) {
+                sum += padded[index(center_row + dy, radius + dx)];
+            }
+        }
+        result[y * width] = sum;
+
+        // Slide it east across the row.
+        for (dimension_type x = 1; x < width; x++) {
+            const auto center_col = x + radius;
+            const auto previous_col = center_col - 1;
+            // East edge of the new diamond.
+            sum += sum_down_right(center_row - radius, center_col, center_row, center_col + radius);
+            // West edge of the previous diamond.
+            sum -= sum_down_left(center_row - radius, previous_col, center_row, previous_col - radius);
+            if (radius > 0) {
+                sum += sum_down_left(center_row + 1, center_col + radius - 1, center_row + radius, center_col);
+                sum -= sum_down_right(center_row + 1, previous_col - radius + 1, center_row + radius, previous_col);
+            }
+            result[y * width + x] = sum;
+        }
+    }
+}
+
+/**
+ * Compute the counts of a single layer by enumerating the distinct cells within the radius.
+ * Used on grids too small for the radius, where offsets alias each other.
+ * @param layer The layer.
+ */
+void OccupancyField::compute_direct(size_t layer) {
+    // Each distinct offset on the wrap-around grid whose distance is within the radius.
+    std::vector<Location> offsets;
+    for (dimension_type dy = 0; dy < height; dy++) {
+        const auto y_distance = std::min(dy, height - dy);
+        for (dimension_type dx = 0; dx < width; dx++) {
+            const auto x_distance = std::min(dx, width - dx);
+            if (x_distance + y_distance <= radius) {
+                offsets.emplace_back(dx, dy);
+            }
+        }
+    }
+
+    const auto plane_offset = layer * static_cast<size_t>(width * height);
+    const auto *plane = occupancy.data() + plane_offset;
+    auto *result = counts.data() + plane_offset;
+    for (dimension_type y = 0; y < height; y++) {
+        for (dimension_type x = 0; x < width; x++) {
+            count_type sum = 0;
+            for (const auto &[dx, dy] : offsets) {
+                sum += plane[((y + dy) % height) * width + (x + dx) % width];
+            }
+            result[y * width + x] = sum;
+        }
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+#ifndef OCCUPANCYFIELD_HPP
+#define OCCUPANCYFIELD_HPP
+
+#include <vector>
+
+#include "Location.hpp"
+
+namespace hlt {
+
+/**
+ * Dense per-layer occupancy planes over a wrap-around grid, together with the number of
+ * occupied cells within a fixed Manhattan radius of every cell.
+ *
+ * Layers are indexed by a dense integer (the player ID value in practice). After adding
+ * all occupants and calling compute(), count() answers in O(1) for any cell.
+ */
+class OccupancyField {
+public:
+    /** The type of occupancy counts. */
+    using count_type = unsigned long;
+
+private:
+    dimension_type width{};   /**< The width of the grid. */
+    dimension_type height{};  /**< The height of the grid. */
+    dimension_type radius{};  /**< The Manhattan radius to count within. */
+    size_t layers{};          /**< The number of layers. */
+
+    /** Occupancy per layer, row-major, each plane width * height. */
+    std::vector<count_type> occupancy;
+    /** Counts within the radius per layer, row-major, each plane width * height. */
+    std::vector<count_type> counts;
+
+    /** Scratch: one occupancy plane padded by the radius on every side, with wraparound. */
+    std::vector<count_type> padded;
+    /** Scratch: prefix sums of the padded plane along down-right diagonals. */
+    std::vector<count_type> down_right;
+    /** Scratch: prefix sums of the padded plane along down-left diagonals. */
+    std::vector<count_type> down_left;
+
+    /**
+     * Compute the counts of a single layer using diagonal prefix sums.
+     * Requires that the diamond of the radius does not wrap onto itself.
+     * @param layer The layer.
+     */
+    void compute_sliding(size_t layer);
+
+    /**
+     * Compute the counts of a single layer by enumerating the distinct cells within the radius.
+     * Used on grids too small for the radius, where offsets alias each other.
+     * @param layer The layer.
+     */
+    void compute_direct(size_t layer);
+
+public:
+    /**
+     * Clear the field and prepare it for a new set of occupants.
+     * Storage is reused across calls with the same dimensions.
+     * @param width The width of the grid.
+     * @param height The height of the grid.
+     * @param layers The number of layers.
+     * @param radius The Manhattan radius to count within.
+     */
+    void reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius);
+
+    /**
+     * Mark a cell as occupied in a layer.
+     * @param layer The layer.
+     * @param location The occupied cell.
+     */
+    void add(size_t layer, const Location &location) {
+        occupancy[layer * width * height + location.y * width + location.x]++;
+    }
+
+    /** Compute the counts within the radius for every layer and cell. */
+    void compute();
+
+    /**
+     * Get the number of occupants of a layer within the radius of a cell.
+     * Only valid after compute().
+     * @param layer The layer.
+     * @param location The cell.
+     * @return The number of occupants.
+     */
+    count_type count(size_t layer, const Location &location) const {
+        return counts[layer * width * height + location.y * width + location.x];
+    }
+};
+
+}
+
+#endif // OCCUPANCYFIELD_HPP
@@ -0,0 +1,70 @@
+#include <algorithm>
+
+#include "PresenceField.hpp"
+
+namespace hlt {
+
+/**
+ * Clear the field and prepare it for a new set of sources.
+ * Storage is reused across calls with the same dimensions.
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @param layers The number of layers.
+ * @param radius The Manhattan radius to search within.
+ */
+void PresenceField::reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius) {
+    this->width = width;
+    this->height = height;
+    this->layers = layers;
+    // A source is always within range of its own cell, even for a negative radius.
+    this->radius = std::max(radius, dimension_type{0});
+    distances.resize(layers * static_cast<size_t>(width * height));
+    present.resize(static_cast<size_t>(width * height));
+    sources.resize(layers);
+    for (auto &layer_sources : sources) {
+        layer_sources.clear();
+    }
+}
+
+/** Compute the distances and presence for every layer and cell. */
+void PresenceField::compute() {
+    std::fill(distances.begin(), distances.end(), radius + 1);
+    std::fill(present.begin(), present.end(), 0);
+    for (size_t layer = 0; layer < layers; layer++) {
+        compute_layer(layer);
+    }
+}
+
+/**
+ * Search outwards from the sources of a single layer, up to the radius.
+ * @param layer The layer.
+ */
+void PresenceField::compute_layer(size_t layer) {
+    auto *plane = distances.data() + layer * static_cast<size_t>(width * height);
+    // Record a cell at a distance if it was not reached before.
+    const auto visit = [this, plane](dimension_type x, dimension_type y, dimension_type distance) {
+        const auto index = static_cast<size_t>(y * width + x);
+        if (plane[index] > radius) {
+            plane[index] = distance;
+            present[index]++;
+            next_frontier.emplace_back(x, y);
+        }
+    };
+
+    next_frontier.clear();
+    for (const auto &[x, y] : sources[layer]) {
+        visit(x, y, 0);
+    }
+    for (dimension_type distance = 1; distance <= radius && !next_frontier.empty(); distance++) {
+        std::swap(frontier, next_frontier);
+        next_frontier.clear();
+        for (const auto &[x, y] : frontier) {
+            visit(x == 0 ? width - 1 : x - 1, y, distance);
+            visit(x + 1 == width ? 0 : x + 1, y, distance);
+            visit(x, y == 0 ? height - 1 : y - 1, distance);
+            visit(x, y + 1 == height ? 0 : y + 1, distance);
+        }
+    }
+}
+
+}
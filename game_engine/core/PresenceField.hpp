@@ -0,0 +1,90 @@
+#ifndef PRESENCEFIELD_HPP
+#define PRESENCEFIELD_HPP
+
+#include <vector>
+
+#include "Location.hpp"
+
+namespace hlt {
+
+/**
+ * Per-layer distance from every cell of a wrap-around grid to the nearest source of that
+ * layer, bounded by a fixed radius, together with the number of layers present within
+ * the radius of every cell.
+ *
+ * Layers are indexed by a dense integer (the player ID value in practice). After adding
+ * all sources and calling compute(), whether any other layer is within the radius of a
+ * cell is answered in O(1).
+ */
+class PresenceField {
+    dimension_type width{};  /**< The width of the grid. */
+    dimension_type height{}; /**< The height of the grid. */
+    dimension_type radius{}; /**< The Manhattan radius to search within. */
+    size_t layers{};         /**< The number of layers. */
+
+    /** Distance to the nearest source per layer, radius + 1 if none is in range, each plane width * height. */
+    std::vector<dimension_type> distances;
+    /** Number of layers with a source within the radius, width * height. */
+    std::vector<size_t> present;
+    /** Sources per layer, the first frontier of the search. */
+    std::vector<std::vector<Location>> sources;
+
+    /** Scratch: the current frontier of the search. */
+    std::vector<Location> frontier;
+    /** Scratch: the next frontier of the search. */
+    std::vector<Location> next_frontier;
+
+    /**
+     * Search outwards from the sources of a single layer, up to the radius.
+     * @param layer The layer.
+     */
+    void compute_layer(size_t layer);
+
+public:
+    /**
+     * Clear the field and prepare it for a new set of sources.
+     * Storage is reused across calls with the same dimensions.
+     * @param width The width of the grid.
+     * @param height The height of the grid.
+     * @param layers The number of layers.
+     * @param radius The Manhattan radius to search within.
+     */
+    void reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius);
+
+    /**
+     * Add a source to a layer.
+     * @param layer The layer.
+     * @param location The location of the source.
+     */
+    void add(size_t layer, const Location &location) { sources[layer].push_back(location); }
+
+    /** Compute the distances and presence for every layer and cell. */
+    void compute();
+
+    /**
+     * Get the distance from a cell to the nearest source of a layer.
+     * Only valid after compute().
+     * @param layer The layer.
+     * @param location The cell.
+     * @return The distance, or radius + 1 if there is no source within the radius.
+     */
+    dimension_type distance(size_t layer, const Location &location) const {
+        return distances[(layer * height + location.y) * width + location.x];
+    }
+
+    /**
+     * Determine whether any layer other than the given one has a source within the radius of a cell.
+     * Only valid after compute().
+     * @param layer The layer to exclude.
+     * @param location The cell.
+     * @return True if another layer is present, false otherwise.
+     */
+    bool other_present(size_t layer, const Location &location) const {
+        const auto own = distance(layer, location) <= radius ? 1u : 0u;
+        return present[location.y * width + location.x] > own;
+    }
+};
+
+}
+
+#endif // PRESENCEFIELD_HPP
@@ -0,0 +1,60 @@
+#include <algorithm>
+
+#include "ProximityField.hpp"
+
+namespace hlt {
+
+/**
+ * Clear the field and prepare it for a new set of occupants.
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @param layers The number of layers.
+ * @param radius The Manhattan radius to count within.
+ */
+void ProximityField::reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius) {
+    this->width = width;
+    this->height = height;
+    this->layers = layers;
+    counts.assign((layers + 1) * static_cast<size_t>(width * height), 0);
+
+    // Walk the square around the origin, keeping offsets whose wrapped distance is within the radius.
+    // On grids smaller than the square, an offset may be kept several times, once per way it is reached.
+    offsets.clear();
+    for (auto dx = -radius; dx <= radius; dx++) {
+        for (auto dy = -radius; dy <= radius; dy++) {
+            const Location offset{((dx % width) + width) % width, ((dy % height) + height) % height};
+            const auto x_distance = std::min(offset.x, width - offset.x);
+            const auto y_distance = std::min(offset.y, height - offset.y);
+            if (x_distance + y_distance <= radius) {
+                offsets.push_back(offset);
+            }
+        }
+    }
+}
+
+/**
+ * Add a delta to every cell within the radius of a location.
+ * @param layer The layer.
+ * @param location The location.
+ * @param delta The delta to add.
+ */
+void ProximityField::stamp(size_t layer, const Location &location, count_type delta) {
+    if (counts.empty()) {
+        return;
+    }
+    const auto plane_size = static_cast<size_t>(width * height);
+    auto *plane = counts.data() + layer * plane_size;
+    auto *total = counts.data() + layers * plane_size;
+    for (const auto &[dx, dy] : offsets) {
+        // The occupant is within range of the cell it is offset from.
+        auto x = location.x - dx;
+        auto y = location.y - dy;
+        if (x < 0) x += width;
+        if (y < 0) y += height;
+        const auto index = static_cast<size_t>(y * width + x);
+        plane[index] += delta;
+        total[index] += delta;
+    }
+}
+
+}
@@ -0,0 +1,84 @@
+#ifndef PROXIMITYFIELD_HPP
+#define PROXIMITYFIELD_HPP
+
+#include <vector>
+
+#include "Location.hpp"
+
+namespace hlt {
+
+/**
+ * Per-layer counts of occupants within a fixed Manhattan radius of every cell of a
+ * wrap-around grid, maintained incrementally as occupants are added and removed.
+ *
+ * Layers are indexed by a dense integer (the player ID value in practice). A running
+ * total over all layers is kept alongside, so that counts of all other layers are O(1).
+ */
+class ProximityField {
+public:
+    /** The type of proximity counts. */
+    using count_type = long;
+
+private:
+    dimension_type width{};  /**< The width of the grid. */
+    dimension_type height{}; /**< The height of the grid. */
+    size_t layers{};         /**< The number of layers. */
+
+    /** Counts per layer followed by the total over all layers, row-major, each plane width * height. */
+    std::vector<count_type> counts;
+    /** The offsets an occupant contributes to, normalized into the grid, with multiplicity. */
+    std::vector<Location> offsets;
+
+    /**
+     * Add a delta to every cell within the radius of a location.
+     * @param layer The layer.
+     * @param location The location.
+     * @param delta The delta to add.
+     */
+    void stamp(size_t layer, const Location &location, count_type delta);
+
+public:
+    /**
+     * Clear the field and prepare it for a new set of occupants.
+     * @param width The width of the grid.
+     * @param height The height of the grid.
+     * @param layers The number of layers.
+     * @param radius The Manhattan radius to count within.
+     */
+    void reset(dimension_type width, dimension_type height, size_t layers, dimension_type radius);
+
+    /**
+     * Add an occupant to a layer. Does nothing if the field was never reset.
+     * @param layer The layer.
+     * @param location The location of the occupant.
+     */
+    void add(size_t layer, const Location &location) { stamp(layer, location, 1); }
+
+    /**
+     * Remove an occupant from a layer. Does nothing if the field was never reset.
+     * @param layer The layer.
+     * @param location The location of the occupant.
+     */
+    void remove(size_t layer, const Location &location) { stamp(layer, location, -1); }
+
+    /**
+     * Get the number of occupants of a layer within the radius of a cell.
+     * @param layer The layer.
+     * @param location The cell.
+     * @return The number of occupants.
+     */
+    count_type count(size_t layer, const Location &location) const {
+        return counts[(layer * height + location.y) * width + location.x];
+    }
+
+    /**
+     * Get the number of occupants of all layers within the radius of a cell.
+     * @param location The cell.
+     * @return The number of occupants.
+     */
+    count_type total(const Location &location) const { return count(layers, location); }
+};
+
+}
+
+#endif // PROXIMITYFIELD_HPP
@@ -0,0 +1,77 @@
+#ifndef RULES_HPP
+#define RULES_HPP
+
+#include "Constants.hpp"
+
+namespace hlt {
+
+/**
+ * Rules policy for the standard competition ruleset.
+ *
+ * The rule parameters are compile-time constants, so that per-turn phases instantiated
+ * with this policy fold them into their loops and drop the branches of disabled rules.
+ */
+struct StandardRules {
+    static constexpr energy_type MAX_ENERGY = 1000;              /**< The maximum energy per entity. */
+    static constexpr unsigned long EXTRACT_RATIO = 4;            /**< The extraction ratio. */
+    static constexpr unsigned long INSPIRED_EXTRACT_RATIO = 4;   /**< The extraction ratio of inspired ships. */
+    static constexpr double INSPIRED_BONUS_MULTIPLIER = 2;       /**< The mining bonus of inspired ships. */
+    static constexpr bool CAPTURE_ENABLED = false;               /**< Whether ships may be captured. */
+    static constexpr dimension_type CAPTURE_RADIUS = 3;          /**< The capture radius. */
+    static constexpr unsigned long SHIPS_ABOVE_FOR_CAPTURE = 3;  /**< The ship advantage needed for capture. */
+    static constexpr bool INSPIRATION_ENABLED = true;            /**< Whether ships may be inspired. */
+    static constexpr dimension_type INSPIRATION_RADIUS = 4;      /**< The inspiration radius. */
+    static constexpr unsigned long INSPIRATION_SHIP_COUNT = 2;   /**< The opponent ships needed for inspiration. */
+
+    /**
+     * Determine whether constants follow the standard ruleset.
+     * @param constants The constants.
+     * @return True if every rule parameter has its standard value.
+     */
+    static bool matches(const Constants &constants) {
+        return constants.MAX_ENERGY == MAX_ENERGY
+               && constants.EXTRACT_RATIO == EXTRACT_RATIO
+               && constants.INSPIRED_EXTRACT_RATIO == INSPIRED_EXTRACT_RATIO
+               && constants.INSPIRED_BONUS_MULTIPLIER == INSPIRED_BONUS_MULTIPLIER
+               && constants.CAPTURE_ENABLED == CAPTURE_ENABLED
+               && constants.CAPTURE_RADIUS == CAPTURE_RADIUS
+               && constants.SHIPS_ABOVE_FOR_CAPTURE == SHIPS_ABOVE_FOR_CAPTURE
+               && constants.INSPIRATION_ENABLED == INSPIRATION_ENABLED
+               && constants.INSPIRATION_RADIUS == INSPIRATION_RADIUS
+               && constants.INSPIRATION_SHIP_COUNT == INSPIRATION_SHIP_COUNT;
+    }
+};
+
+/** Rules policy reading the rule parameters from the constants, for any constants file. */
+struct RuntimeRules {
+    const energy_type MAX_ENERGY;                /**< The maximum energy per entity. */
+    const unsigned long EXTRACT_RATIO;           /**< The extraction ratio. */
+    const unsigned long INSPIRED_EXTRACT_RATIO;  /**< The extraction ratio of inspired ships. */
+    const double INSPIRED_BONUS_MULTIPLIER;      /**< The mining bonus of inspired ships. */
+    const bool CAPTURE_ENABLED;                  /**< Whether ships may be captured. */
+    const dimension_type CAPTURE_RADIUS;         /**< The capture radius. */
+    const unsigned long SHIPS_ABOVE_FOR_CAPTURE; /**< The ship advantage needed for capture. */
+    const bool INSPIRATION_ENABLED;              /**< Whether ships may be inspired. */
+    const dimension_type INSPIRATION_RADIUS;     /**< The inspiration radius. */
+    const unsigned long INSPIRATION_SHIP_COUNT;  /**< The opponent ships needed for inspiration. */
+
+    /**
+     * Read the rule parameters from constants.
+     * @param constants The constants.
+     */
+    explicit RuntimeRules(const Constants &constants) :
+            MAX_ENERGY(constants.MAX_ENERGY),
+            EXTRACT_RATIO(constants.EXTRACT_RATIO),
+            INSPIRED_EXTRACT_RATIO(constants.INSPIRED_EXTRACT_RATIO),
+            INSPIRED_BONUS_MULTIPLIER(constants.INSPIRED_BONUS_MULTIPLIER),
+            CAPTURE_ENABLED(constants.CAPTURE_ENABLED),
+            CAPTURE_RADIUS(constants.CAPTURE_RADIUS),
+            SHIPS_ABOVE_FOR_CAPTURE(constants.SHIPS_ABOVE_FOR_CAPTURE),
+            INSPIRATION_ENABLED(constants.INSPIRATION_ENABLED),
+            INSPIRATION_RADIUS(constants.INSPIRATION_RADIUS),
+            INSPIRATION_SHIP_COUNT(constants.INSPIRATION_SHIP_COUNT) {}
+};
+
+}
+
+#endif // RULES_HPP
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <numeric>
+
 #include "Statistics.hpp"
 
 /** A JSON key and value corresponding to a field. */
@@ -5,6 +8,61 @@
 
 namespace hlt {
 
+/**
+ * Summarize measurements, using the nearest-rank percentiles.
+ * @param samples The measurements, which may be empty.
+ * @return The distribution, all zero if there are no measurements.
+ */
+Distribution Distribution::of(std::vector<long long> samples) {
+    Distribution distribution;
+    if (samples.empty()) {
+        return distribution;
+    }
+    // Each selection leaves the larger samples after the selected one, so later ones search less.
+    auto begin = samples.begin();
+    const auto select = [&samples, &begin](size_t percentile) {
+        const auto rank = (percentile * samples.size() + 99) / 100;
+        const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(std::max<size_t>(rank, 1) - 1);
+        std::nth_element(begin, nth, samples.end());
+        begin = nth;
+        return *nth;
+    };
+    distribution.p50 = select(50);
+    distribution.p95 = select(95);
+    distribution.p99 = select(99);
+    distribution.max = *std::max_element(begin, samples.end());
+    return distribution;
+}
+
+/**
+ * Convert a distribution to JSON format.
+ * @param[out] json The output JSON.
+ * @param distribution The distribution to convert.
+ */
+void to_json(nlohmann::json &json, const Distribution &distribution) {
+    json = {{"p50", distribution.p50},
+            {"p95", distribution.p95},
+            {"p99", distribution.p99},
+            {"max", distribution.max}};
+}
+
+/**
+ * Summarize the timing and traffic of a player.
+ * @param stats The statistics of the player.
+ * @return The JSON.
+ */
+static nlohmann::json player_timing(const PlayerStatistics &stats) {
+    const auto total = [](const std::vector<long long> &samples) {
+        return std::accumulate(samples.begin(), samples.end(), 0LL);
+    };
+    return {{"response_time_us", Distribution::of(stats.turn_response_times)},
+            {"bytes_sent_per_turn", Distribution::of(stats.turn_bytes_sent)},
+            {"bytes_received_per_turn", Distribution::of(stats.turn_bytes_received)},
+            {"bytes_sent", total(stats.turn_bytes_sent)},
+            {"bytes_received", total(stats.turn_bytes_received)},
+            {"failed_turns", stats.failed_turns}};
+}
+
 /**
  * Compare two players to rank them.
  *
@@ -85,4 +143,34 @@ void to_json(nlohmann::json &json, const GameStatistics &stats) {
             FIELD_TO_JSON(map_total_halite)};
 }
 
+/**
+ * Convert the per-turn timing and traffic of a game to JSON format, one array per measurement.
+ * @param statistics The game statistics.
+ * @return The JSON.
+ */
+nlohmann::json timing_series(const GameStatistics &statistics) {
+    nlohmann::json players = nlohmann::json::object();
+    for (const auto &stats : statistics.player_statistics) {
+        players[to_string(stats.player_id)] = {{"response_time_us", stats.turn_response_times},
+                                               {"bytes_sent", stats.turn_bytes_sent},
+                                               {"bytes_received", stats.turn_bytes_received}};
+    }
+    return {{"engine_turn_time_us", statistics.turn_engine_times},
+            {"players", players}};
+}
+
+/**
+ * Convert the percentiles of the timing and traffic of a game to JSON format.
+ * @param statistics The game statistics.
+ * @return The JSON.
+ */
+nlohmann::json timing_summary(const GameStatistics &statistics) {
+    nlohmann::json players = nlohmann::json::object();
+    for (const auto &stats : statistics.player_statistics) {
+        players[to_string(stats.player_id)] = player_timing(stats);
+    }
+    return {{"engine_turn_time_us", Distribution::of(statistics.turn_engine_times)},
+            {"players", players}};
+}
+
 }
@@ -10,6 +10,28 @@
 
 namespace hlt {
 
+/** Percentiles of a measurement taken every turn. */
+struct Distribution {
+    long long p50{}; /**< The median. */
+    long long p95{}; /**< The 95th percentile. */
+    long long p99{}; /**< The 99th percentile. */
+    long long max{}; /**< The maximum. */
+
+    /**
+     * Summarize measurements, using the nearest-rank percentiles.
+     * @param samples The measurements, which may be empty.
+     * @return The distribution, all zero if there are no measurements.
+     */
+    static Distribution of(std::vector<long long> samples);
+
+    /**
+     * Convert a distribution to JSON format.
+     * @param[out] json The output JSON.
+     * @param distribution The distribution to convert.
+     */
+    friend void to_json(nlohmann::json &json, const Distribution &distribution);
+};
+
 /** Statistics for a player in the game. */
 struct PlayerStatistics {
     Player::id_type player_id;                   /**< The ID of the player. */
@@ -38,6 +60,10 @@ struct PlayerStatistics {
     long ships_spawned{};                        /**< The number of ships spawned. */
     long ships_peak{};                           /**< The maximum number of ship spawned at the same time. */
     std::unordered_map<Location, energy_type> halite_per_dropoff{}; /**< The amount of halite collected at each dropoff. */
+    std::vector<long long> turn_response_times{}; /**< Microseconds from sending each turn to the bot until its commands arrived, or it failed. */
+    std::vector<long long> turn_bytes_sent{};     /**< Bytes sent to the bot each turn. */
+    std::vector<long long> turn_bytes_received{}; /**< Bytes received from the bot each turn, with their framing. */
+    long failed_turns{};                         /**< The number of turns on which the bot failed to send valid commands. */
 
     /**
      * Convert Player statistics to JSON format.
@@ -69,6 +95,7 @@ struct GameStatistics {
     unsigned long number_turns{};                           /**< Total number of turns that finished before game ends. */
     energy_type map_total_halite{};                         /**< Total halite available at the start. */
     long long execution_time{};                             /**< Execution time of the game in ms. */
+    std::vector<long long> turn_engine_times{};             /**< Microseconds of each turn not spent waiting for bots. */
 
     unsigned long turn_number{};                            /**< Used to track last_turn_ship_spawn */
 
@@ -81,5 +108,19 @@ struct GameStatistics {
     friend void to_json(nlohmann::json &json, const GameStatistics &statistics);
 };
 
+/**
+ * Convert the per-turn timing and traffic of a game to JSON format, one array per measurement.
+ * @param statistics The game statistics.
+ * @return The JSON.
+ */
+nlohmann::json timing_series(const GameStatistics &statistics);
+
+/**
+ * Convert the percentiles of the timing and traffic of a game to JSON format.
+ * @param statistics The game statistics.
+ * @return The JSON.
+ */
+nlohmann::json timing_summary(const GameStatistics &statistics);
+
 }
 #endif //HALITE_STATISTICS_HPP
@@ -21,9 +21,9 @@ Player &Store::get_player(const Player::id_type &id) {
  * @return The entity.
  */
 Entity &Store::get_entity(const Entity::id_type &id) {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    return iterator->second;
+    auto *entity = entities.find(id);
+    assert(entity != nullptr);
+    return *entity;
 }
 
 /**
@@ -33,32 +33,31 @@ Entity &Store::get_entity(const Entity::id_type &id) {
  * @return The entity.
  */
 const Entity &Store::get_entity(const Entity::id_type &id) const {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    return iterator->second;
+    const auto *entity = entities.find(id);
+    assert(entity != nullptr);
+    return *entity;
 }
 
 /**
  * Obtain a new entity.
+ * References to other entities may be invalidated.
  *
  * @param energy The energy of the entity.
  * @param owner The owner of the entity.
  * @return The new entity.
  */
 Entity &Store::new_entity(energy_type energy, const Player::id_type &owner) {
-    auto entity = entity_factory.make(owner, energy);
-    return entities.emplace(entity.id, entity).first->second;
+    return entities.insert(entity_factory.make(owner, energy));
 }
 
 /**
  * Delete an entity by ID.
+ * References to other entities may be invalidated.
  *
  * @param id The ID of the entity.
  */
 void Store::delete_entity(const Entity::id_type id) {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    entities.erase(iterator);
+    entities.erase(id);
 }
 
 /**
@@ -70,4 +69,45 @@ Dropoff Store::new_dropoff(Location location) {
     return dropoff_factory.make(location);
 }
 
+/**
+ * Give an entity to a player at a location, keeping the inspiration field up to date.
+ *
+ * @param player The player.
+ * @param id The ID of the entity.
+ * @param location The location of the entity.
+ */
+void Store::place_entity(Player &player, const Entity::id_type &id, Location location) {
+    player.add_entity(id, location);
+    get_entity(id).location = location;
+    inspiration_field.add(static_cast<size_t>(player.id.value), location);
+}
+
+/**
+ * Take an entity from a player, keeping the inspiration field up to date.
+ * The entity itself is not deleted.
+ *
+ * @param player The player.
+ * @param id The ID of the entity.
+ */
+void Store::lift_entity(Player &player, const Entity::id_type &id) {
+    inspiration_field.remove(static_cast<size_t>(player.id.value), player.get_entity_location(id));
+    player.remove_entity(id);
+}
+
+/**
+ * Rebuild the inspiration field from the entities of all players.
+ *
+ * @param width The width of the map.
+ * @param height The height of the map.
+ * @param radius The inspiration radius.
+ */
+void Store::reset_inspiration_field(dimension_type width, dimension_type height, dimension_type radius) {
+    inspiration_field.reset(width, height, players.size(), radius);
+    for (const auto &[player_id, player] : players) {
+        for (const auto &[_, location] : player.entities) {
+            inspiration_field.add(static_cast<size_t>(player_id.value), location);
+        }
+    }
+}
+
 }
@@ -1,9 +1,11 @@
 #ifndef STORE_HPP
 #define STORE_HPP
 
-#include <unordered_set>
 
+#include "CellSet.hpp"
+#include "EntityStore.hpp"
 #include "Player.hpp"
+#include "ProximityField.hpp"
 
 namespace net {
 class Networking;
@@ -14,14 +16,14 @@ namespace hlt {
 class Store;
 class StoreEntityIter {
     friend class Store;
-    id_map<Entity, Entity> &entities;
+    EntityStore &entities;
 
-    StoreEntityIter(id_map<Entity, Entity> &entities) : entities{entities} {}
+    StoreEntityIter(EntityStore &entities) : entities{entities} {}
 public:
-    id_map<Entity, Entity>::iterator begin() {
+    EntityStore::iterator begin() {
         return entities.begin();
     }
-    id_map<Entity, Entity>::iterator end() {
+    EntityStore::iterator end() {
         return entities.end();
     }
 };
@@ -34,13 +36,15 @@ class Store {
     friend struct Turn;
 
     ordered_id_map<Player, Player> players;  /**< Map from player ID to player. */
-    id_map<Entity, Entity> entities;         /**< Map from entity ID to entity. */
+    EntityStore entities;                    /**< Map from entity ID to entity. */
 
     Factory<Player> player_factory;   /**< The player factory. */
     Factory<Entity> entity_factory;   /**< The entity factory. */
     Factory<Dropoff> dropoff_factory; /**< The dropoff factory. */
 
-    std::unordered_set<Location> changed_cells{}; /**< The cells changed on the last turn. */
+    CellSet changed_cells{}; /**< The cells changed on the last turn. */
+
+    ProximityField inspiration_field{}; /**< Ships of each player within the inspiration radius of each cell. */
 
 public:
     unsigned long long map_total_energy{}; /**< The total energy remaining on the map. */
@@ -69,6 +73,13 @@ public:
      */
     Entity &get_entity(const Entity::id_type &id);
 
+    /**
+     * Get all players, in ID order.
+     *
+     * @return The players, by ID.
+     */
+    ordered_id_map<Player, Player> &all_players() { return players; }
+
     /**
      * Get an iterator over all entities.
      */
@@ -76,6 +87,7 @@ public:
 
     /**
      * Obtain a new entity.
+     * References to other entities may be invalidated.
      *
      * @param energy The energy of the entity.
      * @param owner The owner of the entity.
@@ -92,10 +104,38 @@ public:
 
     /**
      * Delete an entity by ID.
+     * References to other entities may be invalidated.
      *
      * @param id The ID of the entity.
      */
     void delete_entity(Entity::id_type id);
+
+    /**
+     * Give an entity to a player at a location, keeping the inspiration field up to date.
+     *
+     * @param player The player.
+     * @param id The ID of the entity.
+     * @param location The location of the entity.
+     */
+    void place_entity(Player &player, const Entity::id_type &id, Location location);
+
+    /**
+     * Take an entity from a player, keeping the inspiration field up to date.
+     * The entity itself is not deleted.
+     *
+     * @param player The player.
+     * @param id The ID of the entity.
+     */
+    void lift_entity(Player &player, const Entity::id_type &id);
+
+    /**
+     * Rebuild the inspiration field from the entities of all players.
+     *
+     * @param width The width of the map.
+     * @param height The height of the map.
+     * @param radius The inspiration radius.
+     */
+    void reset_inspiration_field(dimension_type width, dimension_type height, dimension_type radius);
 };
 
 }
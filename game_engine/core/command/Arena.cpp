@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <memory>
+
+#include "Arena.hpp"
+
+namespace hlt {
+
+/**
+ * Allocate memory from the arena.
+ * @param bytes The number of bytes.
+ * @param alignment The alignment.
+ * @return The memory.
+ */
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    void *pointer = buffer.data() + used;
+    auto space = buffer.size() - used;
+    if (std::align(alignment, bytes, pointer, space) != nullptr) {
+        used = buffer.size() - space + bytes;
+        return pointer;
+    }
+    spilled += bytes + alignment;
+    return spill.allocate(bytes, alignment);
+}
+
+/**
+ * Release all memory handed out by the arena, keeping its capacity.
+ * Nothing allocated from the arena may be used afterwards.
+ */
+void Arena::reset() {
+    spill.release();
+    if (spilled > 0) {
+        buffer.resize(std::max(2 * buffer.size(), buffer.size() + spilled));
+    }
+    used = 0;
+    spilled = 0;
+}
+
+}
@@ -0,0 +1,70 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace hlt {
+
+/**
+ * Monotonic memory resource for storage that lives for a single turn.
+ *
+ * Allocations are bumped out of an owned buffer and are never freed individually;
+ * everything is released at once by reset(). Allocations that do not fit spill over
+ * to a monotonic upstream resource, and the next reset() grows the buffer to cover
+ * them, so that once the high-water mark is reached a turn does no heap allocation.
+ */
+class Arena final : public std::pmr::memory_resource {
+    std::vector<std::byte> buffer; /**< The owned buffer. */
+    size_t used{};                 /**< The number of bytes of the buffer handed out. */
+    size_t spilled{};              /**< The number of bytes spilled over since the last reset. */
+    /** The resource for allocations that do not fit in the buffer. */
+    std::pmr::monotonic_buffer_resource spill{std::pmr::new_delete_resource()};
+
+protected:
+    /**
+     * Allocate memory from the arena.
+     * @param bytes The number of bytes.
+     * @param alignment The alignment.
+     * @return The memory.
+     */
+    void *do_allocate(size_t bytes, size_t alignment) override;
+
+    /** Memory is only released by reset(). */
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    /**
+     * Arenas are only equal to themselves.
+     * @param other The other resource.
+     * @return True if the other resource is this arena.
+     */
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+public:
+    /**
+     * Release all memory handed out by the arena, keeping its capacity.
+     * Nothing allocated from the arena may be used afterwards.
+     */
+    void reset();
+
+    /**
+     * Get the capacity of the owned buffer.
+     * @return The capacity in bytes.
+     */
+    size_t capacity() const { return buffer.size(); }
+
+    /**
+     * Construct Arena with an initial capacity.
+     * @param capacity The initial capacity in bytes.
+     */
+    explicit Arena(size_t capacity = 0) : buffer(capacity) {}
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+};
+
+}
+
+#endif // ARENA_HPP
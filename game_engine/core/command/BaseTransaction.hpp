@@ -1,6 +1,8 @@
 #ifndef BASETRANSACTION_HPP
 #define BASETRANSACTION_HPP
 
+#include <memory_resource>
+
 #include "CommandError.hpp"
 #include "GameEvent.hpp"
 #include "Location.hpp"
@@ -25,8 +27,9 @@ private:
     callback<Location> cell_update_callback;          /**< Cell update callback. */
 
 protected:
-    Store &store; /**< The game store. */
-    Map &map;     /**< The game map. */
+    Store &store;                      /**< The game store. */
+    Map &map;                          /**< The game map. */
+    std::pmr::memory_resource *memory; /**< The resource for storage that lives for one transaction. */
 
     /**
      * Process a generated event.
@@ -92,11 +95,14 @@ protected:
 
 public:
     /**
-     * Construct BaseTransaction from Store and Map.
+     * Construct BaseTransaction from Store, Map and memory resource.
      * @param store The Store.
      * @param map The Map.
+     * @param memory The resource for storage that lives for one transaction.
      */
-    explicit BaseTransaction(Store &store, Map &map) : store(store), map(map) {}
+    explicit BaseTransaction(Store &store, Map &map,
+                             std::pmr::memory_resource *memory = std::pmr::get_default_resource()) :
+            store(store), map(map), memory(memory) {}
 
     /**
      * Set a callback for events generated during the transaction commit.
@@ -139,6 +145,19 @@ public:
     /** If the transaction may be committed, commit the transaction. */
     virtual void commit() = 0;
 
+    /**
+     * Forget all commands, so that the transaction may be reused.
+     * Must be called before the memory resource is released.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Remove all commands of a player, so that the rest of the transaction may be committed.
+     * Must be called while the player still owns its entities.
+     * @param player The player.
+     */
+    virtual void remove_player(const Player &player) = 0;
+
     /** Virtual destructor. */
     virtual ~BaseTransaction() = default;
 };
@@ -1,9 +1,7 @@
-#include <memory>
+#include <sstream>
 
 #include "BotCommunicationError.hpp"
 #include "Command.hpp"
-#include "CommandError.hpp"
-#include "CommandTransaction.hpp"
 
 /** The JSON key for command type. */
 constexpr auto JSON_TYPE_KEY = "type";
@@ -16,26 +14,43 @@ constexpr auto JSON_ENERGY_KEY = "energy";
 
 namespace hlt {
 
-template<class T>
-void TransactableCommand<T>::add_to_transaction(Player &player, CommandTransaction &transaction) const {
-    // Invoke overload resolution on CommandTransaction::add_command
-    transaction.add_command(player, static_cast<const T &>(*this));
-}
-
 /**
  * Convert a Command to JSON format.
  * @param[out] json The output JSON.
  * @param command The command to convert.
  */
-void to_json(nlohmann::json &json, const Command &command) { command.to_json(json); }
+void to_json(nlohmann::json &json, const Command &command) {
+    std::visit([&json](const auto &alternative) { alternative.to_json(json); }, command);
+}
 
 /**
- * Convert a Command ptr to JSON format.
- * @param[out] json The output JSON.
- * @param command The command to convert.
+ * Read a Command from JSON format, as written to replays.
+ * @param json The JSON input.
+ * @param[out] command The command read.
+ * @throws BotCommunicationError if the command type is unknown.
  */
+void from_json(const nlohmann::json &json, Command &command) {
+    // The bot serial format has the same fields in the same order, so parse that.
+    std::ostringstream serial;
+    serial << json.at(JSON_TYPE_KEY).get<std::string>();
+    if (json.count(JSON_ENTITY_KEY) > 0) {
+        serial << ' ' << json.at(JSON_ENTITY_KEY).get<id_value_type>();
+    }
+    if (json.count(JSON_DIRECTION_KEY) > 0) {
+        serial << ' ' << json.at(JSON_DIRECTION_KEY).get<std::string>();
+    }
+    std::istringstream istream(serial.str());
+    istream >> command;
+}
 
-void to_json(nlohmann::json &json, const std::unique_ptr<Command> &command) { command->to_json(json); }
+/**
+ * Convert a Command to bot serial format.
+ * @param command The command to convert.
+ * @return The serialized command.
+ */
+std::string to_bot_serial(const Command &command) {
+    return std::visit([](const auto &alternative) { return alternative.to_bot_serial(); }, command);
+}
 
 /**
  * Read a Command from bot serial format.
@@ -43,26 +58,26 @@ void to_json(nlohmann::json &json, const std::unique_ptr<Command> &command) { co
  * @param[out] command The command to read.
  * @return The input stream.
  */
-std::istream &operator>>(std::istream &istream, std::unique_ptr<Command> &command) {
+std::istream &operator>>(std::istream &istream, Command &command) {
     // Read one character corresponding to the type, and dispatch the remainder based on its value.
     char command_type;
     if (istream >> command_type) {
         switch (command_type) {
-        case Command::Name::Move: {
+        case BaseCommand::Name::Move: {
             Entity::id_type entity;
             Direction direction;
             istream >> entity >> direction;
-            command = std::make_unique<MoveCommand>(entity, direction);
+            command = MoveCommand(entity, direction);
             break;
         }
-        case Command::Name::Spawn: {
-            command = std::make_unique<SpawnCommand>();
+        case BaseCommand::Name::Spawn: {
+            command = SpawnCommand();
             break;
         }
-        case Command::Name::Construct: {
+        case BaseCommand::Name::Construct: {
             Entity::id_type entity;
             istream >> entity;
-            command = std::make_unique<ConstructCommand>(entity);
+            command = ConstructCommand(entity);
             break;
         }
         default:
@@ -75,11 +90,11 @@ std::istream &operator>>(std::istream &istream, std::unique_ptr<Command> &comman
 /**
  * Write a Command to bot serial format.
  * @param ostream The output stream.
- * @param[out] command The command to write.
+ * @param command The command to write.
  * @return The output stream.
  */
-std::ostream &operator<<(std::ostream &ostream, std::unique_ptr<Command> &command) {
-    return ostream << command->to_bot_serial();
+std::ostream &operator<<(std::ostream &ostream, const Command &command) {
+    return ostream << to_bot_serial(command);
 }
 
 /**
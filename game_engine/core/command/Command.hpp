@@ -1,6 +1,8 @@
 #ifndef COMMAND_HPP
 #define COMMAND_HPP
 
+#include <variant>
+
 #include "Entity.hpp"
 #include "Map.hpp"
 #include "Player.hpp"
@@ -9,10 +11,11 @@
 
 namespace hlt {
 
-class CommandTransaction;
-
-/** Abstract type of commands issued by the user. */
-class Command {
+/**
+ * Base of the commands issued by the user. Commands are held by value in a Command
+ * variant; the base gives errors a common type by which to refer to the faulty command.
+ */
+class BaseCommand {
 public:
     /** The command names. */
     enum Name : char {
@@ -20,92 +23,28 @@ public:
         Spawn = 'g',
         Construct = 'c'
     };
-
-    /**
-     * Convert to JSON format.
-     * @param[out] json The JSON output.
-     */
-    virtual void to_json(nlohmann::json &json) const = 0;
-
-    /**
-     * Convert to bot serial format.
-     * @return The serialized command.
-     */
-    virtual std::string to_bot_serial() const = 0;
-
-    /**
-     * Add the command to a transaction.
-     * @param player The player executing the command.
-     * @param transaction The command transaction to act on.
-     */
-    virtual void add_to_transaction(Player &player, CommandTransaction &transaction) const = 0;
-
-    /** Virtual destructor. */
-    virtual ~Command() = default;
-};
-
-/** Statically polymorphic mixin for commands that may be added to a transaction. */
-template<class T>
-class TransactableCommand : public Command {
-public:
-    /**
-     * Add the command to a transaction.
-     * @param player The player executing the command.
-     * @param transaction The command transaction to act on.
-     */
-    void add_to_transaction(Player &player, CommandTransaction &transaction) const final;
-
-    /** Virtual destructor. */
-    ~TransactableCommand() override = default;
 };
 
-/**
- * Convert a Command to JSON format.
- * @param[out] json The output JSON.
- * @param command The command to convert.
- */
-void to_json(nlohmann::json &json, const Command &command);
-
-/**
- * Convert a Command ptr to JSON format.
- * @param[out] json The output JSON.
- * @param command The command to convert.
- */
-void to_json(nlohmann::json &json, const std::unique_ptr<Command> &command);
-
-/**
- * Read a Command from bot serial format.
- * @param istream The input stream.
- * @param[out] command The command to read.
- * @return The input stream.
- */
-std::istream &operator>>(std::istream &istream, std::unique_ptr<Command> &command);
-
-/**
- * Write a Command to bot serial format.
- * @param ostream The output stream.
- * @param[out] command The command to write.
- * @return The output stream.
- */
-std::ostream &operator<<(std::ostream &ostream, std::unique_ptr<Command> &command);
-
 /** Command for moving an entity in a direction. */
-class MoveCommand final : public TransactableCommand<MoveCommand> {
+class MoveCommand final : public BaseCommand {
 public:
-    const Entity::id_type entity; /**< The location of the entity. */
-    const Direction direction;    /**< The direction in which to move. */
+    Entity::id_type entity{}; /**< The location of the entity. */
+    Direction direction{};    /**< The direction in which to move. */
 
     /**
      * Convert a MoveCommand to JSON format.
      * @param[out] json The JSON output.
      */
-    void to_json(nlohmann::json &json) const override;
+    void to_json(nlohmann::json &json) const;
 
     /**
      * Convert to bot serial format.
      * @return The serialized command.
      */
-    std::string to_bot_serial() const override;
+    std::string to_bot_serial() const;
+
+    /** Default constructor, for reading commands. */
+    MoveCommand() = default;
 
     /**
      * Create MoveCommand from entity and direction.
@@ -116,44 +55,41 @@ public:
 };
 
 /** Command for spawning an entity. */
-class SpawnCommand final : public TransactableCommand<SpawnCommand> {
+class SpawnCommand final : public BaseCommand {
 public:
     /**
      * Convert a SpawnCommand to JSON format.
      * @param[out] json The JSON output.
      */
-    void to_json(nlohmann::json &json) const override;
+    void to_json(nlohmann::json &json) const;
 
     /**
      * Convert to bot serial format.
      * @return The serialized command.
      */
-    std::string to_bot_serial() const override;
-
-    /**
-     * Create SpawnCommand from energy.
-     * @param energy The energy to use.
-     */
-    explicit SpawnCommand() {}
+    std::string to_bot_serial() const;
 };
 
 /** Command to construct a drop zone. */
-class ConstructCommand final : public TransactableCommand<ConstructCommand> {
+class ConstructCommand final : public BaseCommand {
 public:
     /** The entity to use to construct. */
-    const Entity::id_type entity;
+    Entity::id_type entity{};
 
     /**
      * Convert a ConstructCommand to JSON format.
      * @param[out] json The JSON output.
      */
-    void to_json(nlohmann::json &json) const override;
+    void to_json(nlohmann::json &json) const;
 
     /**
      * Convert to bot serial format.
      * @return The serialized command.
      */
-    std::string to_bot_serial() const override;
+    std::string to_bot_serial() const;
+
+    /** Default constructor, for reading commands. */
+    ConstructCommand() = default;
 
     /**
      * Construct ConstructCommand from entity.
@@ -162,6 +98,50 @@ public:
     explicit ConstructCommand(const Entity::id_type &entity) : entity(entity) {}
 };
 
+/**
+ * A command issued by the user, held by value so that the commands of a turn are
+ * stored contiguously. Dispatch is through std::visit.
+ */
+using Command = std::variant<MoveCommand, SpawnCommand, ConstructCommand>;
+
+/**
+ * Convert a Command to JSON format.
+ * @param[out] json The output JSON.
+ * @param command The command to convert.
+ */
+void to_json(nlohmann::json &json, const Command &command);
+
+/**
+ * Read a Command from JSON format, as written to replays.
+ * @param json The JSON input.
+ * @param[out] command The command read.
+ * @throws BotCommunicationError if the command type is unknown.
+ */
+void from_json(const nlohmann::json &json, Command &command);
+
+/**
+ * Convert a Command to bot serial format.
+ * @param command The command to convert.
+ * @return The serialized command.
+ */
+std::string to_bot_serial(const Command &command);
+
+/**
+ * Read a Command from bot serial format.
+ * @param istream The input stream.
+ * @param[out] command The command to read.
+ * @return The input stream.
+ */
+std::istream &operator>>(std::istream &istream, Command &command);
+
+/**
+ * Write a Command to bot serial format.
+ * @param ostream The output stream.
+ * @param command The command to write.
+ * @return The output stream.
+ */
+std::ostream &operator<<(std::ostream &ostream, const Command &command);
+
 }
 
 #endif // COMMAND_HPP
@@ -0,0 +1,181 @@
+#include <charconv>
+#include <cstdint>
+
+#include "BotCommunicationError.hpp"
+#include "CommandParser.hpp"
+
+namespace hlt {
+
+/**
+ * Determine whether a character separates tokens, as in the classic locale.
+ * @param character The character.
+ * @return True if the character is whitespace.
+ */
+static bool is_space(char character) {
+    switch (character) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\v':
+    case '\f':
+    case '\r':
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Advance past whitespace.
+ * @param input The input.
+ * @param[in,out] position The position in the input.
+ */
+static void skip_space(std::string_view input, size_t &position) {
+    while (position < input.size() && is_space(input[position])) {
+        position++;
+    }
+}
+
+/**
+ * Read a decimal ID, accepting the same forms as stream extraction.
+ * @param input The input.
+ * @param[in,out] position The position in the input, advanced past the ID if it was read.
+ * @param[out] id The ID.
+ * @return True if the ID was read.
+ */
+static bool parse_id(std::string_view input, size_t &position, Entity::id_type &id) {
+    skip_space(input, position);
+    auto begin = input.data() + position;
+    const auto end = input.data() + input.size();
+    // Streams take a plus sign, which from_chars does not, but never both signs
+    if (begin != end && *begin == '+') {
+        begin++;
+        if (begin == end || *begin == '-') {
+            return false;
+        }
+    }
+    const auto [digits_end, error] = std::from_chars(begin, end, id.value);
+    if (error != std::errc()) {
+        return false;
+    }
+    position = static_cast<size_t>(digits_end - input.data());
+    return true;
+}
+
+/**
+ * Read an ID in the binary protocol, a 32-bit little-endian integer.
+ * @param input The input.
+ * @param[in,out] position The position in the input, advanced past the ID if it was read.
+ * @param[out] id The ID.
+ * @return True if the ID was read.
+ */
+static bool parse_binary_id(std::string_view input, size_t &position, Entity::id_type &id) {
+    static constexpr size_t ID_SIZE = 4;
+    if (input.size() - position < ID_SIZE) {
+        return false;
+    }
+    std::uint32_t value = 0;
+    for (size_t i = 0; i < ID_SIZE; i++) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(input[position++])) << (8 * i);
+    }
+    id.value = static_cast<std::int32_t>(value);
+    return true;
+}
+
+/**
+ * Decode a line of commands. As with stream extraction, decoding stops quietly at a
+ * construction whose entity cannot be read.
+ * @param input The line.
+ * @return The commands, valid until the next call.
+ * @throws BotCommunicationError if the line has an unknown command, or a malformed move.
+ */
+const std::vector<Command> &CommandParser::parse(std::string_view input) {
+    commands.clear();
+    size_t position = 0;
+    while (true) {
+        skip_space(input, position);
+        if (position == input.size()) {
+            return commands;
+        }
+        // Read one character corresponding to the type, and dispatch the remainder based on its value.
+        const auto command_type = input[position++];
+        switch (command_type) {
+        case BaseCommand::Name::Move: {
+            MoveCommand command;
+            if (!parse_id(input, position, command.entity)) {
+                throw BotCommunicationError(std::string(input));
+            }
+            skip_space(input, position);
+            if (position == input.size()) {
+                throw BotCommunicationError(std::string(input));
+            }
+            const auto direction_type = input[position++];
+            if (!from_char(direction_type, command.direction)) {
+                throw BotCommunicationError(to_string(direction_type));
+            }
+            commands.emplace_back(command);
+            break;
+        }
+        case BaseCommand::Name::Spawn:
+            commands.emplace_back(SpawnCommand());
+            break;
+        case BaseCommand::Name::Construct: {
+            ConstructCommand command;
+            if (!parse_id(input, position, command.entity)) {
+                return commands;
+            }
+            commands.emplace_back(command);
+            break;
+        }
+        default:
+            // The position is just past the offending character, as reported by tellg.
+            throw BotCommunicationError(to_string(command_type), static_cast<std::streamoff>(position));
+        }
+    }
+}
+
+/**
+ * Decode a record of commands in the binary protocol. Each command is its type character,
+ * followed for moves and constructions by the entity as a 32-bit little-endian integer,
+ * and for moves by the direction character.
+ * @param input The record, without its length.
+ * @return The commands, valid until the next call.
+ * @throws BotCommunicationError if the record has an unknown or truncated command.
+ */
+const std::vector<Command> &CommandParser::parse_binary(std::string_view input) {
+    commands.clear();
+    size_t position = 0;
+    while (position < input.size()) {
+        const auto command_type = input[position++];
+        switch (command_type) {
+        case BaseCommand::Name::Move: {
+            MoveCommand command;
+            if (!parse_binary_id(input, position, command.entity) || position == input.size()) {
+                throw BotCommunicationError(to_string(command_type), static_cast<std::streamoff>(position));
+            }
+            const auto direction_type = input[position++];
+            if (!from_char(direction_type, command.direction)) {
+                throw BotCommunicationError(to_string(direction_type), static_cast<std::streamoff>(position));
+            }
+            commands.emplace_back(command);
+            break;
+        }
+        case BaseCommand::Name::Spawn:
+            commands.emplace_back(SpawnCommand());
+            break;
+        case BaseCommand::Name::Construct: {
+            ConstructCommand command;
+            if (!parse_binary_id(input, position, command.entity)) {
+                throw BotCommunicationError(to_string(command_type), static_cast<std::streamoff>(position));
+            }
+            commands.emplace_back(command);
+            break;
+        }
+        default:
+            throw BotCommunicationError(to_string(command_type), static_cast<std::streamoff>(position));
+        }
+    }
+    return commands;
+}
+
+}
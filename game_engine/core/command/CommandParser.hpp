@@ -0,0 +1,44 @@
+#ifndef COMMANDPARSER_HPP
+#define COMMANDPARSER_HPP
+
+#include <string_view>
+#include <vector>
+
+#include "Command.hpp"
+
+namespace hlt {
+
+/**
+ * Decoder of the command lines sent by bots.
+ *
+ * Scans the line in place rather than through a stream, and decodes into a buffer
+ * that is kept from line to line, so that decoding allocates nothing once the buffer
+ * has grown to the usual number of commands.
+ */
+class CommandParser final {
+    std::vector<Command> commands; /**< The commands of the last line. */
+
+public:
+    /**
+     * Decode a line of commands. As with stream extraction, decoding stops quietly at a
+     * construction whose entity cannot be read.
+     * @param input The line.
+     * @return The commands, valid until the next call.
+     * @throws BotCommunicationError if the line has an unknown command, or a malformed move.
+     */
+    const std::vector<Command> &parse(std::string_view input);
+
+    /**
+     * Decode a record of commands in the binary protocol. Each command is its type character,
+     * followed for moves and constructions by the entity as a 32-bit little-endian integer,
+     * and for moves by the direction character.
+     * @param input The record, without its length.
+     * @return The commands, valid until the next call.
+     * @throws BotCommunicationError if the record has an unknown or truncated command.
+     */
+    const std::vector<Command> &parse_binary(std::string_view input);
+};
+
+}
+
+#endif // COMMANDPARSER_HPP
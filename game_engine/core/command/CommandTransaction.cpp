@@ -6,6 +6,9 @@ namespace hlt {
 /** The maximum number of commands per entity. */
 static constexpr auto MAX_COMMANDS_PER_ENTITY = 1;
 
+/** The initial capacity of the arena, enough for a typical turn. */
+static constexpr size_t INITIAL_ARENA_CAPACITY = 1 << 16;
+
 /**
  * Check that a command operates on an entity owned by the player.
  * @param player The player.
@@ -33,7 +36,7 @@ bool CommandTransaction::check_ownership(const Player &player, Entity::id_type e
  * @param entity The entity.
  * @param command The command.
  */
-void CommandTransaction::add_occurrence(Entity::id_type entity, const Command &command) {
+void CommandTransaction::add_occurrence(Entity::id_type entity, const BaseCommand &command) {
     auto &occurrences_entry = occurrences[entity];
     if (occurrences_entry.first++ == MAX_COMMANDS_PER_ENTITY) {
         // Already seen one entity, this one is illegal
@@ -50,7 +53,7 @@ void CommandTransaction::add_occurrence(Entity::id_type entity, const Command &c
  * @param command The command.
  * @param amount The expense amount.
  */
-void CommandTransaction::add_expense(const Player &player, const Command &command, energy_type amount) {
+void CommandTransaction::add_expense(const Player &player, const BaseCommand &command, energy_type amount) {
     auto &expenses_entry = expenses[player.id];
     if ((expenses_entry.first += amount) > player.energy) {
         if (auto [_, inserted] = expenses_first_faulty.emplace(player.id, command); !inserted) {
@@ -75,7 +78,7 @@ void CommandTransaction::add_command(Player &player, const ConstructCommand &com
 
         // Cost factors in entity cargo and halite on target cell.
         const auto location = player.get_entity_location(command.entity);
-        const auto &cell = map.at(location);
+        const auto cell = map.at(location);
         const auto &entity = store.get_entity(command.entity);
         if (cell.energy + entity.energy >= cost) {
             cost = 0;
@@ -135,14 +138,16 @@ bool CommandTransaction::check() {
     for (auto &[player_id, faulty] : expenses_first_faulty) {
         const auto &player = store.get_player(player_id);
         auto &[energy, context] = expenses[player_id];
-        error_generated<PlayerInsufficientEnergyError>(player_id, faulty, context, player.energy, energy);
+        error_generated<PlayerInsufficientEnergyError>(player_id, faulty, ErrorContext(context.begin(), context.end()),
+                                                       player.energy, energy);
         success = false;
     }
     // Check that each entity is operated on at most once
     for (auto &[entity_id, faulty] : occurrences_first_faulty) {
         const auto owner = store.get_entity(entity_id).owner;
         auto &[_, context] = occurrences[entity_id];
-        error_generated<ExcessiveCommandsError>(owner, faulty, context, entity_id);
+        error_generated<ExcessiveCommandsError>(owner, faulty, ErrorContext(context.begin(), context.end()),
+                                                entity_id);
         success = false;
     }
     // Check that each transaction can succeed individually
@@ -161,6 +166,44 @@ void CommandTransaction::commit() {
     }
 }
 
+/**
+ * Forget all commands, so that the transaction may be reused on the next attempt or turn.
+ * Storage is released to the arena, which keeps its capacity.
+ */
+void CommandTransaction::reset() {
+    // Containers are replaced rather than cleared, since cleared containers keep arena storage.
+    for (BaseTransaction &transaction : all_transactions) {
+        transaction.reset();
+    }
+    occurrences = decltype(occurrences)(memory);
+    occurrences_first_faulty = decltype(occurrences_first_faulty)(memory);
+    expenses = decltype(expenses)(memory);
+    expenses_first_faulty = decltype(expenses_first_faulty)(memory);
+    move_ownership_faulty = decltype(move_ownership_faulty)(memory);
+    construct_ownership_faulty = decltype(construct_ownership_faulty)(memory);
+    arena.reset();
+}
+
+/**
+ * Remove all commands of a player, so that the rest of the transaction may be committed.
+ * Must be called while the player still owns its entities.
+ * @param player The player.
+ */
+void CommandTransaction::remove_player(const Player &player) {
+    for (BaseTransaction &transaction : all_transactions) {
+        transaction.remove_player(player);
+    }
+    // Occurrences are only recorded for commands on entities of the commanding player.
+    for (const auto &[entity_id, _] : player.entities) {
+        occurrences.erase(entity_id);
+        occurrences_first_faulty.erase(entity_id);
+    }
+    expenses.erase(player.id);
+    expenses_first_faulty.erase(player.id);
+    move_ownership_faulty.erase(player.id);
+    construct_ownership_faulty.erase(player.id);
+}
+
 /**
  * Set a callback for events generated during the transaction commit.
  * @param callback The callback to set.
@@ -211,10 +254,11 @@ void CommandTransaction::on_cell_update(callback <Location> callback) {
  * @param map The Map.
  */
 CommandTransaction::CommandTransaction(Store &store, Map &map) :
-        BaseTransaction(store, map),
-        dump_transaction(store, map),
-        construct_transaction(store, map),
-        move_transaction(store, map),
-        spawn_transaction(store, map) {}
+        BaseTransaction(store, map, &arena),
+        arena(INITIAL_ARENA_CAPACITY),
+        dump_transaction(store, map, &arena),
+        construct_transaction(store, map, &arena),
+        move_transaction(store, map, &arena),
+        spawn_transaction(store, map, &arena) {}
 
 }
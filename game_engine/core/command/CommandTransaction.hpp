@@ -1,24 +1,31 @@
 #ifndef COMMANDTRANSACTION_HPP
 #define COMMANDTRANSACTION_HPP
 
+#include "Arena.hpp"
 #include "Transaction.hpp"
 
 namespace hlt {
 
 /** Transaction for all commands. */
 class CommandTransaction final : public BaseTransaction {
+    /** The type of lists of commands kept as error context. */
+    using Context = std::pmr::vector<std::reference_wrapper<const BaseCommand>>;
+
+    /** Storage for this transaction and its sub-transactions, released on reset. */
+    Arena arena;
+
     /** Command occurrences per entity, to catch duplicates. */
-    id_map<Entity, std::pair<int, ErrorContext>> occurrences;
+    pmr_id_map<Entity, std::pair<int, Context>> occurrences{memory};
     /** First command which broke occurrences requirement. */
-    id_map<Entity, std::reference_wrapper<const Command>> occurrences_first_faulty;
+    pmr_id_map<Entity, std::reference_wrapper<const BaseCommand>> occurrences_first_faulty{memory};
     /** Total expenses per player. */
-    id_map<Player, std::pair<energy_type, ErrorContext>> expenses;
+    pmr_id_map<Player, std::pair<energy_type, Context>> expenses{memory};
     /** First command which broke expense requirement. */
-    id_map<Player, std::reference_wrapper<const Command>> expenses_first_faulty;
+    pmr_id_map<Player, std::reference_wrapper<const BaseCommand>> expenses_first_faulty{memory};
     /** Commands which break ownership requirement. */
-    id_map<Player, std::vector<std::reference_wrapper<const MoveCommand>>> move_ownership_faulty;
+    pmr_id_map<Player, std::pmr::vector<std::reference_wrapper<const MoveCommand>>> move_ownership_faulty{memory};
     /** Commands which break ownership requirement. */
-    id_map<Player, std::vector<std::reference_wrapper<const ConstructCommand>>> construct_ownership_faulty;
+    pmr_id_map<Player, std::pmr::vector<std::reference_wrapper<const ConstructCommand>>> construct_ownership_faulty{memory};
 
     /**
      * Check that a command operates on an entity owned by the player.
@@ -35,7 +42,7 @@ class CommandTransaction final : public BaseTransaction {
      * @param entity The entity.
      * @param command The command.
      */
-    void add_occurrence(Entity::id_type entity, const Command &command);
+    void add_occurrence(Entity::id_type entity, const BaseCommand &command);
 
     /**
      * Add an expense for a player.
@@ -43,7 +50,7 @@ class CommandTransaction final : public BaseTransaction {
      * @param command The command.
      * @param amount The expense amount.
      */
-    void add_expense(const Player &player, const Command &command, energy_type amount);
+    void add_expense(const Player &player, const BaseCommand &command, energy_type amount);
 
 public:
     DumpTransaction dump_transaction;           /**< The transaction for auto-dumping. */
@@ -85,6 +92,19 @@ public:
     /** If the transaction may be committed, commit the transaction. */
     void commit() override;
 
+    /**
+     * Forget all commands, so that the transaction may be reused on the next attempt or turn.
+     * Storage is released to the arena, which keeps its capacity.
+     */
+    void reset() override;
+
+    /**
+     * Remove all commands of a player, so that the rest of the transaction may be committed.
+     * Must be called while the player still owns its entities.
+     * @param player The player.
+     */
+    void remove_player(const Player &player) override;
+
     /**
      * Set a callback for events generated during the transaction commit.
      * @param callback The callback to set.
@@ -111,6 +131,7 @@ public:
 
     /**
      * Construct CommandTransaction from Store and map.
+     * The transaction is meant to live across turns, with reset() called between uses.
      * @param store The Store.
      * @param map The Map.
      */
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <deque>
 
 #include "Transaction.hpp"
@@ -10,11 +11,10 @@ namespace hlt {
  * Dump energy onto a cell.
  *
  * @param store The game store.
- * @param location The location at which to dump.
  * @param cell The cell at which to dump.
  * @param energy The dumped amount of energy.
  */
-void dump_energy(Store &store, const Location &location, Cell &cell, energy_type energy) {
+void dump_energy(Store &store, CellRef cell, energy_type energy) {
      if (cell.owner == Player::None) {
         // Just dump directly onto the cell.
         cell.energy += energy;
@@ -26,25 +26,21 @@ void dump_energy(Store &store, const Location &location, Cell &cell, energy_type
 
         // Track how much energy is deposited in each dropoff
         player.total_energy_deposited += energy;
-        if (location == player.factory) {
+        if (cell.structure == Player::FACTORY) {
             player.factory_energy_deposited += energy;
         }
         else {
-            for (auto &dropoff : player.dropoffs) {
-                if (dropoff.location == location) {
-                    dropoff.deposited_halite += energy;
-                    return;
-                }
-            }
-            assert(false);
+            assert(cell.structure > Player::FACTORY
+                   && cell.structure <= static_cast<Player::structure_type>(player.dropoffs.size()));
+            player.dropoffs[static_cast<size_t>(cell.structure - 1)].deposited_halite += energy;
         }
     }
 }
 
-void dump_energy(Store &store, Entity &entity, const Location &location, Cell &cell, energy_type energy) {
+void dump_energy(Store &store, Entity &entity, CellRef cell, energy_type energy) {
     // Decrease the entity's energy.
     entity.energy -= energy;
-    dump_energy(store, location, cell, energy);
+    dump_energy(store, cell, energy);
 }
 
 /**
@@ -58,15 +54,23 @@ bool DumpTransaction::check() {
 /** If the transaction may be committed, commit the transaction. */
 void DumpTransaction::commit() {
     // If an entity ends the turn on their dropoff or shipyard,
-    // auto-dump all their energy.
-    for (auto &[entity_id, entity] : store.all_entities()) {
-        const auto &player = store.get_player(entity.owner);
-        const auto &location = player.get_entity_location(entity.id);
-        auto &cell = map.at(location);
-        if (cell.owner == entity.owner) {
-            dump_energy(store, entity, location, cell, entity.energy);
-            cell_updated(location);
-            entity_updated(entity.id);
+    // auto-dump all their energy. Only the structures need to be visited.
+    for (const auto &[player_id, player] : store.all_players()) {
+        const auto dump_at = [this, player_id = player_id](const Location &location) {
+            auto cell = map.at(location);
+            if (cell.owner != player_id || cell.entity == Entity::None) {
+                return;
+            }
+            auto &entity = store.get_entity(cell.entity);
+            if (entity.owner == player_id) {
+                dump_energy(store, entity, cell, entity.energy);
+                cell_updated(location);
+                entity_updated(entity.id);
+            }
+        };
+        dump_at(player.factory);
+        for (const auto &dropoff : player.dropoffs) {
+            dump_at(dropoff.location);
         }
     }
 }
@@ -86,7 +90,7 @@ bool ConstructTransaction::check() {
                 success = false;
             } else {
                 const auto location = player.get_entity_location(command.entity);
-                const auto &cell = map.at(location);
+                const auto cell = map.at(location);
                 if (cell.owner != Player::None) {
                     // Cell is already owned
                     error_generated<CellOwnedError<ConstructCommand>>(player_id, command, location, cell.owner);
@@ -107,11 +111,12 @@ void ConstructTransaction::commit() {
             const auto entity_id = command.entity;
             const auto &entity = store.get_entity(entity_id);
             const auto location = player.get_entity_location(entity_id);
-            auto &cell = map.at(location);
+            auto cell = map.at(location);
 
             // Mark as owned, clear contents of cell
             cell.owner = player_id;
             player.dropoffs.emplace_back(store.new_dropoff(location));
+            cell.structure = static_cast<Player::structure_type>(player.dropoffs.size());
             store.map_total_energy -= cell.energy;
 
             // Cost is reduced by cargo + halite on cell
@@ -123,11 +128,11 @@ void ConstructTransaction::commit() {
             cell_updated(location);
 
             // Use dump_halite for stats tracking
-            dump_energy(store, location, cell, credit);
+            dump_energy(store, cell, credit);
             // Charge player
             player.energy -= cost;
 
-            player.remove_entity(entity_id);
+            store.lift_entity(player, entity_id);
             store.delete_entity(entity_id);
         }
     }
@@ -154,10 +159,12 @@ bool MoveTransaction::check() {
 
 /** If the transaction may be committed, commit the transaction. */
 void MoveTransaction::commit() {
-    // Map from destination location to all the entities that want to go there.
-    std::unordered_map<Location, std::vector<Entity::id_type>> destinations;
-    /** Map from entity to the command that caused it to move. */
-    id_map<Entity, std::reference_wrapper<const MoveCommand>> causes;
+    // Claims are kept empty between commits, so only the cells claimed here need clearing after.
+    claims.resize(static_cast<size_t>(map.width * map.height));
+    claimed.clear();
+    const auto claim_at = [this](const Location &location) -> Claim & {
+        return claims[static_cast<size_t>(location.y * map.width + location.x)];
+    };
     // Lift each entity that is moving from the grid.
     for (auto &[player_id, moves] : commands) {
         auto &player = store.get_player(player_id);
@@ -167,7 +174,7 @@ void MoveTransaction::commit() {
                 continue;
             }
             auto location = player.get_entity_location(command.entity);
-            auto &source = map.at(location);
+            auto source = map.at(location);
             auto &entity = store.get_entity(command.entity);
 
             // Check if entity has enough energy
@@ -182,81 +189,98 @@ void MoveTransaction::commit() {
                                                                       required, !Constants::get().STRICT_ERRORS);
                 continue;
             }
-            causes.emplace(command.entity, command);
             // Decrease the entity's energy.
             entity.energy -= required;
             // Remove the entity from its source.
             source.entity = Entity::None;
             map.move_location(location, command.direction);
             // Mark it as interested in the destination.
-            destinations[location].emplace_back(command.entity);
+            auto &claim = claim_at(location);
+            if (claim.size == 0) {
+                claimed.push_back(location);
+            }
+            claim.add(command.entity, &command);
             // Take it from its owner.
             // Do not mark the entity as removed in the game yet.
-            store.get_player(entity.owner).remove_entity(command.entity);
+            store.lift_entity(store.get_player(entity.owner), command.entity);
         }
     }
     // If there are already unmoving entities at the destination, lift them off too.
-    for (auto &[destination, _] : destinations) {
-        auto &cell = map.at(destination);
+    for (const auto &destination : claimed) {
+        auto cell = map.at(destination);
         if (cell.entity != Entity::None) {
-            destinations[destination].emplace_back(cell.entity);
-            store.get_player(store.get_entity(cell.entity).owner).remove_entity(cell.entity);
+            claim_at(destination).add(cell.entity, nullptr);
+            store.lift_entity(store.get_player(store.get_entity(cell.entity).owner), cell.entity);
             cell.entity = Entity::None;
         }
     }
     // If only one entity is interested in a destination, place it there.
     // Otherwise, destroy all interested entities.
     static constexpr auto MAX_ENTITIES_PER_CELL = 1;
-    for (auto &[destination, entities] : destinations) {
-        auto &cell = map.at(destination);
-        if (entities.size() > MAX_ENTITIES_PER_CELL) {
+    for (const auto &destination : claimed) {
+        auto &claim = claim_at(destination);
+        auto cell = map.at(destination);
+        if (claim.size > MAX_ENTITIES_PER_CELL) {
             // Destroy all interested entities and collect them in replay info
-            std::vector<Entity::id_type> collision_ids;
-            id_map<Player, std::vector<Entity::id_type>> self_collisions;
-            id_map<Player, std::deque<std::reference_wrapper<const MoveCommand>>> self_collision_commands;
-            for (auto &entity_id : entities) {
-                auto &entity = store.get_entity(entity_id);
-                collision_ids.push_back(entity_id);
-                self_collisions[entity.owner].emplace_back(entity_id);
-                if (auto cause = causes.find(entity_id); cause != causes.end()) {
-                    self_collision_commands[entity.owner].emplace_back(cause->second);
-                }
-                // Don't delete entities/dump energy until after
-                // generating the event, so that HaliteImpl has a
-                // chance to collect statistics.
+            const std::vector<Entity::id_type> collision_ids(claim.entities.begin(),
+                                                             claim.entities.begin() + claim.size);
+            std::array<Player::id_type, Claim::CAPACITY> owners;
+            for (size_t index = 0; index < claim.size; index++) {
+                owners[index] = store.get_entity(claim.entities[index]).owner;
             }
-            for (const auto &[player_id, self_collision_entities] : self_collisions) {
+            // Report each player colliding with itself once, at its first entity in the claim.
+            for (size_t first = 0; first < claim.size; first++) {
+                const auto player_id = owners[first];
+                if (std::find(owners.begin(), owners.begin() + first, player_id) != owners.begin() + first) {
+                    continue;
+                }
+                std::vector<Entity::id_type> self_collision_entities;
+                // The first command of the player is reported, the rest are context.
+                const MoveCommand *self_collision_command = nullptr;
+                ErrorContext context;
+                for (auto index = first; index < claim.size; index++) {
+                    if (owners[index] == player_id) {
+                        self_collision_entities.push_back(claim.entities[index]);
+                        if (claim.causes[index] == nullptr) {
+                            continue;
+                        }
+                        if (self_collision_command == nullptr) {
+                            self_collision_command = claim.causes[index];
+                        } else {
+                            context.emplace_back(*claim.causes[index]);
+                        }
+                    }
+                }
                 if (self_collision_entities.size() > MAX_ENTITIES_PER_CELL) {
-                    auto &commands = self_collision_commands[player_id];
-                    const MoveCommand &first = commands.front();
-                    commands.pop_front();
-                    const ErrorContext context{commands.begin(), commands.end()};
-                    error_generated<SelfCollisionError<MoveCommand>>(player_id, first, context, destination,
+                    // At most one entity was not moving, so one of the player's entities was moved.
+                    error_generated<SelfCollisionError<MoveCommand>>(player_id, *self_collision_command,
+                                                                     std::move(context), destination,
                                                                      self_collision_entities,
                                                                      !Constants::get().STRICT_ERRORS);
                 }
             }
-
-            // When generating the event, HaliteImpl will record
-            // statistics.
+            // Don't delete entities/dump energy until after
+            // generating the event, so that HaliteImpl has a
+            // chance to collect statistics.
             event_generated<CollisionEvent>(destination, collision_ids);
             // Now we can delete the entities.
             for (const auto &entity_id : collision_ids) {
                 auto &entity = store.get_entity(entity_id);
                 // Dump the energy.
-                dump_energy(store, entity, destination, cell, entity.energy);
+                dump_energy(store, entity, cell, entity.energy);
                 store.delete_entity(entity_id);
             }
 
             cell_updated(destination);
         } else {
-            auto &entity_id = entities.front();
+            const auto entity_id = claim.entities.front();
             // Place it on the map.
             cell.entity = entity_id;
             // Give it back to the owner.
-            store.get_player(store.get_entity(entity_id).owner).add_entity(entity_id, destination);
+            store.place_entity(store.get_player(store.get_entity(entity_id).owner), entity_id, destination);
             entity_updated(entity_id);
         }
+        claim.size = 0;
     }
 }
 
@@ -272,17 +296,17 @@ bool SpawnTransaction::check() {
     for (const auto &[player_id, spawns] : commands) {
         if (spawns.size() > MAX_SPAWNS_PER_TURN) {
             success = false;
-            std::deque<std::reference_wrapper<const Command>> spawns_deque{spawns.begin(), spawns.end()};
+            std::deque<std::reference_wrapper<const BaseCommand>> spawns_deque{spawns.begin(), spawns.end()};
             // First spawn is legal
-            const Command &legal = spawns_deque.front();
+            const BaseCommand &legal = spawns_deque.front();
             spawns_deque.pop_front();
             // Second is illegal
-            const Command &illegal = spawns_deque.front();
+            const BaseCommand &illegal = spawns_deque.front();
             spawns_deque.pop_front();
             // Remainder are in context
             ErrorContext context;
             context.push_back(legal);
-            for (const Command &spawn : spawns_deque) {
+            for (const BaseCommand &spawn : spawns_deque) {
                 context.push_back(spawn);
             }
             error_generated<ExcessiveSpawnsError>(player_id, illegal, context);
@@ -299,13 +323,14 @@ void SpawnTransaction::commit() {
         for (const SpawnCommand &spawn : spawns) {
             auto &player = store.get_player(player_id);
             player.energy -= cost;
-            auto &cell = map.at(player.factory);
-            auto &entity = store.new_entity(0, player.id);
-            player.add_entity(entity.id, player.factory);
-            entity_updated(entity.id);
-            event_generated<SpawnEvent>(player.factory, 0, player.id, entity.id);
+            auto cell = map.at(player.factory);
+            // Hold the ID only, since deleting the existing entity may move the new one.
+            const auto entity_id = store.new_entity(0, player.id).id;
+            store.place_entity(player, entity_id, player.factory);
+            entity_updated(entity_id);
+            event_generated<SpawnEvent>(player.factory, 0, player.id, entity_id);
             if (cell.entity == Entity::None) {
-                cell.entity = entity.id;
+                cell.entity = entity_id;
             } else {
                 // There is a collision, collide with the existing.
                 auto &existing_entity = store.get_entity(cell.entity);
@@ -314,18 +339,18 @@ void SpawnTransaction::commit() {
 
                 if (existing_entity.owner == cell.owner) {
                     error_generated<SelfCollisionError<SpawnCommand>>(player_id, spawn, ErrorContext(), player.factory,
-                                                                      std::vector<Entity::id_type>{cell.entity, entity.id},
+                                                                      std::vector<Entity::id_type>{cell.entity, entity_id},
                                                                       !Constants::get().STRICT_ERRORS);
                 }
-                event_generated<CollisionEvent>(owner.factory, std::vector<Entity::id_type>{cell.entity, entity.id});
+                event_generated<CollisionEvent>(owner.factory, std::vector<Entity::id_type>{cell.entity, entity_id});
 
                 // Use dump_energy in case the collision was from a
                 // different player.
-                dump_energy(store, existing_entity, owner.factory, cell, existing_entity.energy);
-                existing_player.remove_entity(cell.entity);
+                dump_energy(store, existing_entity, cell, existing_entity.energy);
+                store.lift_entity(existing_player, cell.entity);
                 store.delete_entity(cell.entity);
-                player.remove_entity(entity.id);
-                store.delete_entity(entity.id);
+                store.lift_entity(player, entity_id);
+                store.delete_entity(entity_id);
                 cell.entity = Entity::None;
             }
         }
@@ -1,6 +1,8 @@
 #ifndef TRANSACTION_HPP
 #define TRANSACTION_HPP
 
+#include <array>
+#include <cassert>
 #include <functional>
 #include <unordered_set>
 #include <utility>
@@ -12,7 +14,7 @@
 
 namespace hlt {
 
-class Command;
+class BaseCommand;
 
 /**
  * Transactions that execute a series of player commands atomically.
@@ -21,8 +23,8 @@ class Command;
 template<class Command>
 class Transaction : public BaseTransaction {
 protected:
-    using Commands = std::vector<std::reference_wrapper<const Command>>; /**< The type of the player command list. */
-    id_map<Player, Commands> commands;                                   /**< The stored commands per player. */
+    using Commands = std::pmr::vector<std::reference_wrapper<const Command>>; /**< The type of the player command list. */
+    pmr_id_map<Player, Commands> commands{memory};                            /**< The stored commands per player. */
 public:
     using BaseTransaction::BaseTransaction;
 
@@ -35,6 +37,22 @@ public:
         commands[player.id].emplace_back(command);
     }
 
+    /**
+     * Forget all commands, so that the transaction may be reused.
+     * Must be called before the memory resource is released.
+     */
+    void reset() override {
+        commands = pmr_id_map<Player, Commands>(memory);
+    }
+
+    /**
+     * Remove all commands of a player, so that the rest of the transaction may be committed.
+     * @param player The player.
+     */
+    void remove_player(const Player &player) override {
+        commands.erase(player.id);
+    }
+
     /** Virtual destructor. */
     ~Transaction() override = default;
 };
@@ -79,6 +97,31 @@ public:
 
 /** Transaction for MoveCommand. */
 class MoveTransaction final : public Transaction<MoveCommand> {
+    /** The entities that want to end the turn on a cell. */
+    struct Claim {
+        /** At most one entity can arrive from each neighbor, and one can already be on the cell. */
+        static constexpr size_t CAPACITY = 5;
+
+        std::array<Entity::id_type, CAPACITY> entities;   /**< The claiming entities, movers first. */
+        std::array<const MoveCommand *, CAPACITY> causes; /**< The command moving each entity, or null. */
+        size_t size{};                                    /**< The number of claiming entities. */
+
+        /**
+         * Add an entity to the claim.
+         * @param entity The entity.
+         * @param cause The command moving the entity, or null if it is not moving.
+         */
+        void add(Entity::id_type entity, const MoveCommand *cause) {
+            assert(size < CAPACITY);
+            entities[size] = entity;
+            causes[size] = cause;
+            size++;
+        }
+    };
+
+    std::vector<Claim> claims;     /**< The claim on every cell, row-major, empty between commits. */
+    std::vector<Location> claimed; /**< The cells with a claim, in the order they were first claimed. */
+
 public:
     using Transaction::Transaction;
 
@@ -11,7 +11,7 @@
 
 namespace hlt {
 
-class Command;
+class BaseCommand;
 
 class BaseCommandError;
 
@@ -19,7 +19,7 @@ class BaseCommandError;
 using CommandError = std::unique_ptr<BaseCommandError>;
 
 /** The type of a command context. */
-using ErrorContext = std::deque<std::reference_wrapper<const Command>>;
+using ErrorContext = std::deque<std::reference_wrapper<const BaseCommand>>;
 
 /** Error for when bot commands are logically invalid. */
 class BaseCommandError : public BotError {
@@ -44,7 +44,7 @@ public:
      * Get the command that caused the error.
      * @return The command.
      */
-    virtual const Command &command() const = 0;
+    virtual const BaseCommand &command() const = 0;
 
     /**
      * Get the context commands of the error, i.e. the other commands that contributed to the issue.
@@ -78,7 +78,7 @@ public:
 /** Error for when too many commands are issued to an entity. */
 class ExcessiveCommandsError : public BaseCommandError {
 private:
-    const Command &_command;      /**< The command that caused the error. */
+    const BaseCommand &_command;      /**< The command that caused the error. */
 
 public:
     const Entity::id_type entity; /**< The entity. */
@@ -87,7 +87,7 @@ public:
      * Get the command that caused the error.
      * @return The command.
      */
-    const Command &command() const override { return _command; }
+    const BaseCommand &command() const override { return _command; }
 
     /**
      * Get a message printed immediately before the context if there is any.
@@ -111,7 +111,7 @@ public:
      * @param entity The entity.
      * @param ignored Whether this error was ignored by the engine.
      */
-    ExcessiveCommandsError(Player::id_type player, const Command &command, ErrorContext context,
+    ExcessiveCommandsError(Player::id_type player, const BaseCommand &command, ErrorContext context,
                            Entity::id_type entity, bool ignored = false) :
             BaseCommandError(player, std::move(context), ignored), _command(command), entity(entity) {
         buffer = log_message();
@@ -121,14 +121,14 @@ public:
 /** Error for when too many spawn commands are attempted on one turn. */
 class ExcessiveSpawnsError : public BaseCommandError {
 private:
-    const Command &_command;      /**< The command that caused the error. */
+    const BaseCommand &_command;      /**< The command that caused the error. */
 
 public:
     /**
      * Get the command that caused the error.
      * @return The command.
      */
-    const Command &command() const override { return _command; }
+    const BaseCommand &command() const override { return _command; }
 
     /**
      * Get a message printed immediately before the context if there is any.
@@ -151,7 +151,7 @@ public:
      * @param context The command context.
      * @param ignored Whether this error was ignored by the engine.
      */
-    ExcessiveSpawnsError(Player::id_type player, const Command &command,
+    ExcessiveSpawnsError(Player::id_type player, const BaseCommand &command,
                          ErrorContext context, bool ignored = false)
             : BaseCommandError(player, std::move(context), ignored), _command(command) {
         buffer = log_message();
@@ -235,7 +235,7 @@ public:
 /** Error for when player energy is insufficient. */
 class PlayerInsufficientEnergyError : public BaseCommandError {
 private:
-    const Command &_command;      /**< The command that caused the error. */
+    const BaseCommand &_command;      /**< The command that caused the error. */
 
 public:
     const energy_type available; /**< The available energy. */
@@ -245,7 +245,7 @@ public:
      * Get the command that caused the error.
      * @return The command.
      */
-    const Command &command() const override { return _command; }
+    const BaseCommand &command() const override { return _command; }
 
     /**
      * Get a message for the player log.
@@ -270,7 +270,7 @@ public:
      * @param requested The requested energy.
      * @param ignored Whether this error was ignored by the engine.
      */
-    PlayerInsufficientEnergyError(Player::id_type player, const Command &command, ErrorContext context,
+    PlayerInsufficientEnergyError(Player::id_type player, const BaseCommand &command, ErrorContext context,
                                   energy_type available, energy_type requested, bool ignored = false) :
             BaseCommandError(player, std::move(context), ignored), _command(command),
             available(available), requested(requested) {
@@ -6,7 +6,9 @@
 
 std::mutex Logging::cerr_mutex;
 
-long Logging::turn_number = init_turn;
+thread_local long Logging::turn_number = init_turn;
+
+thread_local std::string Logging::game_label;
 
 /** The names of the log levels, indexed by level. */
 constexpr char const *level_names[] = {"debug", "info", "warn", "error"};
@@ -55,6 +57,9 @@ void Logging::_log(const std::string &message, Level level, class_id<hlt::Player
               << level_names[level_num]
               << "] ";
 #endif
+    if (!game_label.empty()) {
+        std::cerr << "[" << game_label << "] ";
+    }
     if (turn_number >= 0) {
         std::cerr << "[" << turn_number << "] ";
     }
@@ -71,3 +76,28 @@ void Logging::_log(const std::string &message, Level level, class_id<hlt::Player
 void Logging::set_turn_number(long turn_number) {
     Logging::turn_number = turn_number;
 }
+
+/**
+ * Set the label of the current game, prefixed to messages on this thread.
+ * @param game_label The game label.
+ */
+void Logging::set_game_label(std::string game_label) {
+    Logging::game_label = std::move(game_label);
+}
+
+/**
+ * Get the per-game logging state of this thread.
+ * @return The context.
+ */
+Logging::Context Logging::get_context() {
+    return {turn_number, game_label};
+}
+
+/**
+ * Adopt per-game logging state on this thread.
+ * @param context The context, as obtained from get_context().
+ */
+void Logging::set_context(const Context &context) {
+    turn_number = context.turn_number;
+    game_label = context.game_label;
+}
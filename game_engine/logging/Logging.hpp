@@ -46,8 +46,17 @@ struct Logging {
     /** Sentinel turn number for after the game ended. */
     static constexpr long ended = -2;
 
-    /** The current turn number. */
-    static long turn_number;
+    /** The current turn number, per thread so concurrent games keep their own. */
+    static thread_local long turn_number;
+
+    /** The label of the current game, per thread; empty when only one game runs. */
+    static thread_local std::string game_label;
+
+    /** The per-game logging state of a thread, to carry it over to helper threads. */
+    struct Context {
+        long turn_number;       /**< The turn number. */
+        std::string game_label; /**< The game label. */
+    };
 
     /** Whether logging is enabled. */
     static bool enabled;
@@ -70,6 +79,24 @@ struct Logging {
      */
     static void set_turn_number(long turn_number);
 
+    /**
+     * Set the label of the current game, prefixed to messages on this thread.
+     * @param game_label The game label.
+     */
+    static void set_game_label(std::string game_label);
+
+    /**
+     * Get the per-game logging state of this thread.
+     * @return The context.
+     */
+    static Context get_context();
+
+    /**
+     * Adopt per-game logging state on this thread.
+     * @param context The context, as obtained from get_context().
+     */
+    static void set_context(const Context &context);
+
     /**
      * Log a suspended (possibly not yet evaluated) message to console.
      * @tparam Message The type of the suspended message.
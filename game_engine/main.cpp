@@ -2,13 +2,16 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <thread>
 
+#include "BatchRunner.hpp"
 #include "Constants.hpp"
-#include "Generator.hpp"
-#include "Halite.hpp"
+#include "GameRunner.hpp"
 #include "Logging.hpp"
 #include "Replay.hpp"
-#include "Snapshot.hpp"
+#include "Resimulation.hpp"
+#include "SnapshotError.hpp"
+#include "version.hpp"
 
 #include "tclap/CmdLine.h"
 
@@ -34,6 +37,8 @@ int main(int argc, char *argv[]) {
     SwitchArg no_compression_switch("", "no-compression", "Disables compression for output files. (They will just be plain JSON.)", cmd, false);
     SwitchArg json_results_switch("", "results-as-json", "Prints game results as JSON at end.", cmd, false);
     SwitchArg strict_switch("", "strict", "Enables strict error reporting mode.", cmd, false);
+    SwitchArg replay_timing_switch("", "replay-timing", "Adds the response time and traffic of each player, "
+                                   "and the engine time, of every turn to the replay.", cmd, false);
     ValueArg<unsigned long> players_arg("n", "players", "Create a map that will accommodate n players.", false, 1,
                                         "positive integer", cmd);
     ValueArg<hlt::dimension_type> width_arg("", "width", "The width of the map.", false,
@@ -57,7 +62,14 @@ int main(int argc, char *argv[]) {
     MultiArg<std::string> override_args("o", "override-names", "Overrides player-sent names.", false, "name strings",
                                         cmd);
     MultiSwitchArg verbosity_arg("v", "verbosity", "Increase the logging verbosity level.", cmd);
-    UnlabeledMultiArg<std::string> command_args("bot-commands", "Start commands for bots.", true, "path strings", cmd);
+    ValueArg<std::string> batch_arg("", "batch", "JSON file listing games to run concurrently, instead of one game.",
+                                    false, "", "path to file", cmd);
+    ValueArg<std::string> resimulate_arg("", "resimulate", "Replay the recorded commands of a replay without bots, "
+                                         "reporting turns per second and whether the frames match.",
+                                         false, "", "path to replay", cmd);
+    ValueArg<unsigned int> threads_arg("", "threads", "The number of batch games to run at once.",
+                                       false, 0, "positive integer", cmd);
+    UnlabeledMultiArg<std::string> command_args("bot-commands", "Start commands for bots.", false, "path strings", cmd);
 
     cmd.parse(argc, argv);
 
@@ -84,20 +96,6 @@ int main(int argc, char *argv[]) {
         constants.STRICT_ERRORS = true;
     }
 
-    // Set the random seed
-    auto seed = seed_arg.isSet() ? seed_arg.getValue() : static_cast<unsigned int>(engine_start.time_since_epoch().count());
-
-    // Use the seed to determine default map size
-    std::mt19937 rng(seed);
-    std::vector<hlt::dimension_type> map_sizes = {32, 40, 48, 56, 64};
-    auto base_size = map_sizes[rng() % map_sizes.size()];
-    constants.DEFAULT_MAP_WIDTH = constants.DEFAULT_MAP_HEIGHT = base_size;
-
-    // Get the map parameters
-    auto map_width = width_arg.isSet() ? width_arg.getValue() : constants.DEFAULT_MAP_WIDTH;
-    auto map_height = height_arg.isSet() ? height_arg.getValue() : constants.DEFAULT_MAP_HEIGHT;
-    auto n_players = players_arg.getValue();
-
     auto verbosity = verbosity_arg.getValue();
     if (!verbosity_arg.isSet()) {
         verbosity = 3;
@@ -109,167 +107,90 @@ int main(int argc, char *argv[]) {
         Logging::set_enabled(false);
     }
 
-    // Read the player bot commands
-    auto bot_commands = command_args.getValue();
-    if (bot_commands.size() > constants.MAX_PLAYERS) {
-        Logging::log("Too many players (max is " + std::to_string(constants.MAX_PLAYERS) + ")", Logging::Level::Error);
-        return 1;
-    } else if (bot_commands.size() > n_players) {
-        n_players = bot_commands.size();
-        if (players_arg.isSet()) {
-            Logging::log("Overriding the specified number of players", Logging::Level::Warning);
-        }
-    }
-
-    hlt::mapgen::MapType type;
-    std::istringstream type_stream(map_type_arg.getValue());
-    type_stream >> type;
-    hlt::mapgen::MapParameters map_parameters{type, seed, map_width, map_height, n_players};
-
-    hlt::Snapshot snapshot;
-    if (!snapshot_arg.getValue().empty()) {
+    // Re-simulate a replay, if requested
+    if (resimulate_arg.isSet()) {
+        hlt::ResimulationReport report;
         try {
-            snapshot = hlt::Snapshot::from_str(snapshot_arg.getValue());
-        } catch (const SnapshotError &err) {
-            std::cerr << err.what() << std::endl;
+            report = hlt::resimulate(hlt::Replay::read(resimulate_arg.getValue()));
+        } catch (const std::exception &err) {
+            Logging::log(std::string("Could not re-simulate replay: ") + err.what(), Logging::Level::Error);
             return 1;
         }
-        map_parameters = snapshot.map_param;
-    }
-
-    net::NetworkingConfig networking_config{};
-    networking_config.ignore_timeout = timeout_switch.getValue();
-
-    hlt::Map map(map_parameters.width, map_parameters.height);
-    hlt::mapgen::Generator::generate(map, map_parameters);
-
-    std::string replay_directory = replay_arg.getValue();
-    if (replay_directory.back() != SEPARATOR) replay_directory.push_back(SEPARATOR);
-
-    hlt::GameStatistics game_statistics;
-    hlt::Replay replay{game_statistics, map_parameters.num_players, map_parameters.seed, map};
-    Logging::log("Map seed is " + std::to_string(map_parameters.seed));
-
-    for (const auto &row : map.grid) {
-        for (const auto &cell : row) {
-            game_statistics.map_total_halite += cell.energy;
+        const nlohmann::json report_json = report;
+        Logging::log("Re-simulated " + std::to_string(report.turns) + " turns in "
+                     + std::to_string(report.seconds) + " s ("
+                     + std::to_string(report_json["turns_per_second"].get<double>()) + " turns/s)");
+        if (report.matches) {
+            Logging::log("All frames match the replay");
+        } else {
+            Logging::log("Frame " + std::to_string(report.first_mismatch) + " does not match the replay",
+                         Logging::Level::Error);
         }
-    }
-
-    hlt::Halite game(map, networking_config, game_statistics, replay);
-    game.run_game(bot_commands, snapshot);
-
-    const auto &overrides = override_args.getValue();
-    auto idx = 0;
-    for (const auto &name : overrides) {
-        if (idx < static_cast<int>(replay.players.size())) {
-            replay.players.at(hlt::Player::id_type{idx}).name = name;
+        if (json_results_switch.getValue()) {
+            std::cout << report_json.dump(JSON_INDENT_LEVEL) << std::endl;
         }
-        idx++;
+        return report.matches ? 0 : 1;
     }
 
-    // JSON results info, used by backend
-    nlohmann::json results;
-    results["error_logs"] = nlohmann::json::object();
-    results["terminated"] = nlohmann::json::object();
-
-    // Output replay file for visualizer
-
-    // While compilers like G++4.8 report C++11 compatibility, they do not
-    // support std::put_time, so we have to use strftime instead.
-    const auto time = std::time(nullptr);
-    const auto localtime = std::localtime(&time);
-    static constexpr size_t MAX_DATE_STRING_LENGTH = 25;
-    char time_string[MAX_DATE_STRING_LENGTH];
-    std::strftime(time_string, MAX_DATE_STRING_LENGTH, "%Y%m%d-%H%M%S%z", localtime);
-	
-    game_statistics.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - engine_start).count();
-
-    if (!no_replay_switch.getValue()) {
-        // Output gamefile. First try the replays folder; if that fails, just use the straight filename.
-        std::stringstream filename_buf;
-        filename_buf << "replay-" << std::string(time_string);
-        filename_buf << "-" << replay.map_generator_seed;
-        filename_buf << "-" << map.width;
-        filename_buf << "-" << map.height << ".hlt";
-        auto filename = filename_buf.str();
-        std::string output_filename = replay_directory + filename;
-        results["replay"] = output_filename;
-        bool enable_compression = !no_compression_switch.getValue();
+    hlt::RunnerConfig config;
+    config.replay_directory = replay_arg.getValue();
+    if (config.replay_directory.back() != SEPARATOR) config.replay_directory.push_back(SEPARATOR);
+    config.write_replay = !no_replay_switch.getValue();
+    config.write_logs = !no_logs_switch.getValue();
+    config.compress = !no_compression_switch.getValue();
+    config.ignore_timeout = timeout_switch.getValue();
+    config.replay_timing = replay_timing_switch.getValue();
+
+    // Run a batch of games concurrently, if requested
+    if (batch_arg.isSet()) {
+        std::vector<hlt::GameSpec> specs;
         try {
-            replay.output(output_filename, enable_compression);
-        } catch (std::runtime_error &e) {
-            Logging::log("Error: could not write replay to directory " + replay_directory + ", falling back on current directory.", Logging::Level::Error);
-            replay_directory = "./";
-            output_filename = replay_directory + filename;
-            replay.output(output_filename, enable_compression);
+            std::ifstream batch_file(batch_arg.getValue());
+            nlohmann::json batch_json;
+            batch_file >> batch_json;
+            specs = hlt::read_batch(batch_json);
+        } catch (const nlohmann::json::exception &err) {
+            Logging::log(std::string("Malformed batch file: ") + err.what(), Logging::Level::Error);
+            return 1;
         }
-        Logging::log("Opening a file at " + output_filename);
-    }
-
-    for (const auto &stats : replay.game_statistics.player_statistics) {
-        std::stringstream message;
-        message << "Player "
-                << to_string(stats.player_id)
-                << ", '"
-                << replay.players.at(stats.player_id).name
-                << "', was rank "
-                << std::to_string(stats.rank)
-                << " with "
-                << std::to_string(stats.turn_productions.back())
-                << " halite";
-        Logging::log(message.str());
+        auto num_threads = threads_arg.isSet() ? threads_arg.getValue() : std::thread::hardware_concurrency();
+        auto results = hlt::run_batch(specs, config, num_threads);
+        if (json_results_switch.getValue()) {
+            std::cout << results.dump(JSON_INDENT_LEVEL) << std::endl;
+        }
+        return 0;
     }
 
-    for (const auto &[player_id, player] : replay.players) {
-        std::string error_log = game.logs.str(player_id);
-        if (!error_log.empty()) {
-            if (!no_logs_switch.getValue() || player.terminated) {
-                std::stringstream logname_buf;
-                logname_buf << "errorlog-" << std::string(time_string)
-                            << "-" << replay.map_generator_seed
-                            << "-" << map_width
-                            << "-" << map_height
-                            << "-" << player_id
-                            << ".log";
-                const auto log_filename = logname_buf.str();
-                auto log_filepath = replay_directory + log_filename;
-
-                std::ofstream log_file;
-                log_file.open(log_filepath, std::ios_base::out);
-                if (!log_file.is_open()) {
-                    log_filepath = replay_directory + log_filename;
-                    log_file.open(log_filepath, std::ios_base::out);
-                }
+    hlt::GameSpec spec;
+    // Set the random seed
+    spec.seed = seed_arg.isSet() ? seed_arg.getValue() : static_cast<unsigned int>(engine_start.time_since_epoch().count());
+    spec.width = width_arg.isSet() ? width_arg.getValue() : 0;
+    spec.height = height_arg.isSet() ? height_arg.getValue() : 0;
+    spec.num_players = players_arg.getValue();
+    std::istringstream type_stream(map_type_arg.getValue());
+    type_stream >> spec.map_type;
+    spec.names = override_args.getValue();
+    spec.snapshot = snapshot_arg.getValue();
 
-                results["error_logs"][to_string(player_id)] = log_filepath;
-                log_file.write(error_log.c_str(), error_log.size());
-                Logging::log("Player has log output. Writing a log at " + log_filepath,
-                             Logging::Level::Info, player.id);
-            }
-            else {
-                Logging::log("Player has log output, but log was suppressed.",
-                             Logging::Level::Info, player.id);
-            }
-            results["terminated"][to_string(player_id)] = player.terminated;
-        }
+    // Read the player bot commands
+    spec.bot_commands = command_args.getValue();
+    if (spec.bot_commands.empty()) {
+        Logging::log("No bot commands given", Logging::Level::Error);
+        return 1;
+    } else if (spec.bot_commands.size() > spec.num_players && players_arg.isSet()
+               && spec.bot_commands.size() <= constants.MAX_PLAYERS) {
+        Logging::log("Overriding the specified number of players", Logging::Level::Warning);
     }
-	
-    results["execution_time"] = game_statistics.execution_time;
-    results["map_width"] = map_width;
-    results["map_height"] = map_height;
-    results["map_total_halite"] = game_statistics.map_total_halite;
-    results["map_seed"] = seed;
-    std::ostringstream stream;
-    stream << type;
-    results["map_generator"] = stream.str();
-    results["final_snapshot"] = game.to_snapshot(map_parameters);
-    results["stats"] = nlohmann::json::object();
-    for (const auto &stats : replay.game_statistics.player_statistics) {
-        results["stats"][to_string(stats.player_id)] = {
-            {"rank", stats.rank},
-            {"score", stats.turn_productions.back()}
-        };
+
+    nlohmann::json results;
+    try {
+        results = hlt::run_game(spec, config, engine_start);
+    } catch (const std::invalid_argument &err) {
+        Logging::log(err.what(), Logging::Level::Error);
+        return 1;
+    } catch (const SnapshotError &err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
     }
 
     if (json_results_switch.getValue()) {
@@ -2,6 +2,7 @@
 #define CELL_HPP
 
 #include <iostream>
+#include <type_traits>
 
 #include "Entity.hpp"
 #include "Player.hpp"
@@ -15,6 +16,8 @@ struct Cell final {
     energy_type energy{};                   /**< Energy of this Cell. */
     Entity::id_type entity = Entity::None;  /**< Entity on this Cell. */
     Player::id_type owner = Player::None;   /**< Owner of this Cell if there is one. */
+    /** Handle of the structure of the owner on this Cell if there is one. */
+    Player::structure_type structure = Player::NO_STRUCTURE;
 
     /**
      * Convert a Cell to JSON format.
@@ -32,6 +35,32 @@ struct Cell final {
     friend std::ostream &operator<<(std::ostream &ostream, const Cell &cell);
 };
 
+/**
+ * Reference to a Cell whose fields are stored apart, in the planes of a Map.
+ * @tparam is_const Whether the fields may only be read.
+ */
+template<bool is_const>
+struct BasicCellRef final {
+    /** The type of a reference to a field. */
+    template<class T>
+    using field_reference = std::conditional_t<is_const, const T, T> &;
+
+    field_reference<energy_type> energy;      /**< Energy of this Cell. */
+    field_reference<Entity::id_type> entity;  /**< Entity on this Cell. */
+    field_reference<Player::id_type> owner;   /**< Owner of this Cell if there is one. */
+    /** Handle of the structure of the owner on this Cell if there is one. */
+    field_reference<Player::structure_type> structure;
+
+    /** Copy the referenced fields into a Cell. */
+    operator Cell() const { return {energy, entity, owner, structure}; }
+};
+
+/** Mutable reference to a Cell of a Map. */
+using CellRef = BasicCellRef<false>;
+
+/** Read-only reference to a Cell of a Map. */
+using ConstCellRef = BasicCellRef<true>;
+
 }
 
 #endif // CELL_HPP
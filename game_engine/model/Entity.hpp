@@ -3,6 +3,7 @@
 
 #include "Constants.hpp"
 #include "Enumerated.hpp"
+#include "Location.hpp"
 
 namespace hlt {
 
@@ -15,8 +16,9 @@ using player_id_type = class_id<Player>;
 struct Entity final : public Enumerated<Entity> {
     friend class Factory<Entity>;
 
-    const player_id_type owner; /**< Owner of the entity. */
+    player_id_type owner;       /**< Owner of the entity. Never changes; not const so entities can be stored densely. */
     energy_type energy;         /**< Energy of the entity. */
+    Location location{0, 0};    /**< Location of the entity, while its owner holds it. */
     bool was_captured;          /**< Track whether this entity was captured for statistics purposes. */
     bool is_inspired;           /**< Track whether or not this entity is currently inspired. */
 
@@ -1,9 +1,14 @@
 #ifndef ENUMERATED_HPP
 #define ENUMERATED_HPP
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
@@ -99,9 +104,6 @@ public:
      * @param id The ID.
      */
     explicit Enumerated(id_type id) : id(id) {}
-
-    /** Virtual destructor. */
-    virtual ~Enumerated() = default;
 };
 
 namespace std {
@@ -128,6 +130,244 @@ using ordered_id_map = std::map<typename K::id_type, V>;
 template<class K, class V>
 using id_map = std::unordered_map<typename K::id_type, V>;
 
+/** Type of maps from ID to arbitrary value, allocating from a memory resource. */
+template<class K, class V>
+using pmr_id_map = std::pmr::unordered_map<typename K::id_type, V>;
+
+/**
+ * Map from ID to arbitrary value, stored contiguously and sorted by ID.
+ *
+ * A table indexed by ID value locates each entry, so lookups, removals and reinsertions
+ * take constant time. Removing an entry only vacates it, and inserting its ID again fills
+ * it in place, so an entity lifted off the map and placed back stays where it was. IDs are
+ * handed out in increasing order, so new IDs are appended; vacated entries are dropped when
+ * they outnumber the others, before an append. Only inserting an ID smaller than the
+ * largest, as when a ship changes owner, shifts entries. Iteration skips vacated entries
+ * and is in ID order.
+ * @tparam K The class whose ID is the key.
+ * @tparam V The type of values.
+ */
+template<class K, class V>
+class flat_id_map {
+public:
+    /** The type of keys. */
+    using key_type = typename K::id_type;
+    /** The type of entries. */
+    using value_type = std::pair<key_type, V>;
+    /** The type of sizes. */
+    using size_type = size_t;
+
+private:
+    /** Marker for IDs without an entry. */
+    static constexpr auto NO_SLOT = static_cast<size_t>(-1);
+
+    std::vector<value_type> entries; /**< The entries, sorted by key, including vacated ones. */
+    std::vector<char> occupied;      /**< Whether each entry is in the map, rather than vacated. */
+    std::vector<size_t> slots;       /**< Position in entries by key value, or NO_SLOT. */
+    size_type count{};               /**< The number of entries in the map. */
+
+    /**
+     * Iterator over the entries in the map, skipping vacated ones.
+     * @tparam Map The type of the map, const or not.
+     * @tparam Entry The type of the entries, const or not.
+     */
+    template<class Map, class Entry>
+    class basic_iterator {
+        friend class flat_id_map;
+
+        Map *map;        /**< The map. */
+        size_t position; /**< The position in the entries. */
+
+        /** Advance to the next entry in the map, if the current one is vacated. */
+        void skip() {
+            while (position < map->entries.size() && !map->occupied[position]) {
+                position++;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Entry>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Entry *;
+        using reference = Entry &;
+
+        /**
+         * Construct an iterator at the first entry in the map from a position on.
+         * @param map The map.
+         * @param position The position.
+         */
+        basic_iterator(Map *map, size_t position) : map(map), position(position) { skip(); }
+
+        reference operator*() const { return map->entries[position]; }
+        pointer operator->() const { return &map->entries[position]; }
+        basic_iterator &operator++() {
+            position++;
+            skip();
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const basic_iterator &other) const { return position == other.position; }
+        bool operator!=(const basic_iterator &other) const { return position != other.position; }
+    };
+
+    /**
+     * Get the position of an entry.
+     * @param key The key.
+     * @return The position, which may be vacated, or NO_SLOT if there is none.
+     */
+    size_t slot(const key_type &key) const {
+        const auto index = static_cast<size_t>(key.value);
+        return key.value >= 0 && index < slots.size() ? slots[index] : NO_SLOT;
+    }
+
+    /**
+     * Point the table at the entries from a position on.
+     * @param first The position.
+     */
+    void index_from(size_t first) {
+        for (auto position = first; position < entries.size(); position++) {
+            const auto index = static_cast<size_t>(entries[position].first.value);
+            if (index >= slots.size()) {
+                slots.resize(index + 1, NO_SLOT);
+            }
+            slots[index] = position;
+        }
+    }
+
+    /** Drop the vacated entries. */
+    void compact() {
+        size_t kept = 0;
+        for (size_t position = 0; position < entries.size(); position++) {
+            if (occupied[position]) {
+                entries[kept++] = std::move(entries[position]);
+            } else {
+                slots[static_cast<size_t>(entries[position].first.value)] = NO_SLOT;
+            }
+        }
+        entries.erase(entries.begin() + static_cast<std::ptrdiff_t>(kept), entries.end());
+        occupied.assign(kept, true);
+        index_from(0);
+    }
+
+public:
+    /** The type of iterators. */
+    using iterator = basic_iterator<flat_id_map, value_type>;
+    /** The type of const iterators. */
+    using const_iterator = basic_iterator<const flat_id_map, const value_type>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, entries.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, entries.size()); }
+    size_type size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * Find the entry with a key.
+     * @param key The key.
+     * @return Iterator to the entry, or end() if there is none.
+     */
+    iterator find(const key_type &key) {
+        const auto position = slot(key);
+        return position != NO_SLOT && occupied[position] ? iterator(this, position) : end();
+    }
+
+    /**
+     * Find the entry with a key.
+     * @param key The key.
+     * @return Iterator to the entry, or end() if there is none.
+     */
+    const_iterator find(const key_type &key) const {
+        const auto position = slot(key);
+        return position != NO_SLOT && occupied[position] ? const_iterator(this, position) : end();
+    }
+
+    /**
+     * Insert an entry if there is none with its key.
+     * @param key The key.
+     * @param value The value.
+     * @return Iterator to the entry with the key, and whether it was inserted.
+     */
+    std::pair<iterator, bool> emplace(const key_type &key, V value) {
+        auto position = slot(key);
+        if (position != NO_SLOT) {
+            if (occupied[position]) {
+                return {iterator(this, position), false};
+            }
+            // Fill the vacated entry in place
+            entries[position].second = std::move(value);
+            occupied[position] = true;
+            count++;
+            return {iterator(this, position), true};
+        }
+        if (entries.size() - count > count) {
+            compact();
+        }
+        if (entries.empty() || entries.back().first < key) {
+            position = entries.size();
+            entries.emplace_back(key, std::move(value));
+            occupied.push_back(true);
+            index_from(position);
+        } else {
+            const auto after = std::lower_bound(entries.begin(), entries.end(), key,
+                                                [](const value_type &entry, const key_type &key) {
+                                                    return entry.first < key;
+                                                });
+            position = static_cast<size_t>(after - entries.begin());
+            entries.emplace(after, key, std::move(value));
+            occupied.insert(occupied.begin() + static_cast<std::ptrdiff_t>(position), true);
+            index_from(position);
+        }
+        count++;
+        return {iterator(this, position), true};
+    }
+
+    /**
+     * Remove an entry, vacating it.
+     * @param position Iterator to the entry.
+     * @return Iterator to the following entry.
+     */
+    iterator erase(iterator position) {
+        occupied[position.position] = false;
+        count--;
+        return iterator(this, position.position + 1);
+    }
+
+    /**
+     * Replace the contents with a range of entries, which must be sorted by key.
+     * @tparam InputIt The type of iterators over the range.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     */
+    template<class InputIt>
+    void assign(InputIt first, InputIt last) {
+        for (const auto &entry : entries) {
+            slots[static_cast<size_t>(entry.first.value)] = NO_SLOT;
+        }
+        entries.assign(first, last);
+        occupied.assign(entries.size(), true);
+        count = entries.size();
+        index_from(0);
+    }
+
+    /**
+     * Convert a map to JSON format, as an array of key and value pairs.
+     * @param[out] json The output JSON.
+     * @param map The map to convert.
+     */
+    friend void to_json(nlohmann::json &json, const flat_id_map &map) {
+        json = nlohmann::json::array();
+        for (const auto &entry : map) {
+            json.push_back(entry);
+        }
+    }
+};
+
 /**
  * Generic factory class that creates classes with an enumerated ID.
  * @tparam T The class to instantiate.
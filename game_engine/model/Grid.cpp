@@ -15,9 +15,14 @@ namespace hlt {
  */
 template<class Entry>
 void to_json(nlohmann::json &json, const Grid<Entry> &grid) {
+    // The grid is written as an array of rows, without any padding.
+    auto rows = nlohmann::json::array();
+    for (dimension_type y = 0; y < grid.height; y++) {
+        rows.emplace_back(std::vector<Entry>(grid.row(y), grid.row(y) + grid.width));
+    }
     json = {FIELD_TO_JSON(width),
             FIELD_TO_JSON(height),
-            FIELD_TO_JSON(grid)};
+            {"grid", rows}};
 }
 
 }
@@ -2,11 +2,25 @@
 #define GRID_HPP
 
 #include <cassert>
+#include <vector>
 
 #include "Location.hpp"
 
 namespace hlt {
 
+/**
+ * Get the smallest power of two not less than a dimension.
+ * @param dimension The dimension.
+ * @return The power of two.
+ */
+constexpr dimension_type next_power_of_two(dimension_type dimension) {
+    dimension_type power = 1;
+    while (power < dimension) {
+        power <<= 1;
+    }
+    return power;
+}
+
 /**
  * Template for classes representing grids indexable along two dimensions.
  * @tparam Entry The type of entries in the grid.
@@ -15,24 +29,28 @@ template<class Entry>
 class Grid {
 public:
     /** The type of the grid. */
-    using grid_type = std::vector<std::vector<Entry>>;
+    using grid_type = std::vector<Entry>;
 
     dimension_type width{};   /**< The width of the grid. */
     dimension_type height{};  /**< The height of the grid. */
+    dimension_type stride{};  /**< The distance between the starts of consecutive rows in the storage. */
 
-    /** The internal data storage. */
+    /**
+     * The internal data storage, row-major, one row every stride entries.
+     * Entries past the width of a row are padding and do not belong to the grid.
+     */
     grid_type grid;
 
     /**
      * Create a Grid from dimensions.
      * @param width The width.
      * @param height The height.
+     * @param power_of_two_stride Whether to pad rows to a power of two, so rows start at aligned offsets.
+     * @param initial The initial value of every entry.
      */
-    Grid(dimension_type width, dimension_type height) : width(width), height(height) {
-        grid.resize(static_cast<typename grid_type::size_type>(height));
-        for (auto &row : grid) {
-            row.resize(static_cast<typename std::remove_reference_t<decltype(row)>::size_type>(width));
-        }
+    Grid(dimension_type width, dimension_type height, bool power_of_two_stride = false, const Entry &initial = Entry()) :
+            width(width), height(height), stride(power_of_two_stride ? next_power_of_two(width) : width) {
+        grid.resize(static_cast<typename grid_type::size_type>(stride * height), initial);
     }
 
     /** Default constructor. */
@@ -47,6 +65,19 @@ public:
     template<class T>
     friend void to_json(nlohmann::json &json, const hlt::Grid<T> &grid);
 
+    /**
+     * Get the storage index of grid coordinates.
+     * @param x The grid x-coordinate.
+     * @param y The grid y-coordinate.
+     * @return The index of (x, y) in the storage.
+     */
+    typename grid_type::size_type index(dimension_type x, dimension_type y) const {
+        // Indexing by rows then columns gives us a grid memory representation that is consistent
+        // with the physical grid.
+        assert(0 <= y && y < height && 0 <= x && x < width);
+        return static_cast<typename grid_type::size_type>(y * stride + x);
+    }
+
     /**
      * Get a reference to an entry at grid coordinates.
      * @param x The grid x-coordinate.
@@ -54,10 +85,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     Entry &at(dimension_type x, dimension_type y) {
-        // Flipping x and y gives us a grid memory representation that is consistent
-        // with the physical grid, indexed by rows then columns.
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(x, y)];
     }
 
     /**
@@ -67,8 +95,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     const Entry &at(dimension_type x, dimension_type y) const {
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(x, y)];
     }
 
     /**
@@ -77,9 +104,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     Entry &at(const Location &location) {
-        auto [x, y] = location;
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(location.x, location.y)];
     }
 
     /**
@@ -88,9 +113,25 @@ public:
      * @return Reference to the entry at (x, y).
      */
     const Entry &at(const Location &location) const {
-        auto [x, y] = location;
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(location.x, location.y)];
+    }
+
+    /**
+     * Get a pointer to the first entry of a row. The row is width entries long.
+     * @param y The grid y-coordinate.
+     * @return Pointer to the entry at (0, y).
+     */
+    Entry *row(dimension_type y) {
+        return grid.data() + index(0, y);
+    }
+
+    /**
+     * Get a const pointer to the first entry of a row. The row is width entries long.
+     * @param y The grid y-coordinate.
+     * @return Pointer to the entry at (0, y).
+     */
+    const Entry *row(dimension_type y) const {
+        return grid.data() + index(0, y);
     }
 
     /**
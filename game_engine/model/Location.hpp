@@ -26,6 +26,14 @@ enum class Direction : char {
  */
 void to_json(nlohmann::json &json, const Direction &direction);
 
+/**
+ * Convert a char to a Direction.
+ * @param direction_char The character.
+ * @param[out] direction The converted direction.
+ * @return true if the conversion was successful.
+ */
+bool from_char(char direction_char, Direction &direction);
+
 /**
  * Read a Direction from bot serial format.
  * @param istream The input stream.
@@ -1,3 +1,5 @@
+#include <numeric>
+
 #include "Map.hpp"
 
 /** Convert a field to JSON. */
@@ -16,16 +18,29 @@ namespace hlt {
 std::array<Location, Map::NEIGHBOR_COUNT> Map::get_neighbors(const Location &location) const {
     // Allow wrap around neighbors
     auto [x, y] = location;
-    return {{{(x + 1) % width, y},
-             {(x - 1 + width) % width, y},
-             {x, (y + 1) % height},
-             {x, (y - 1 + height) % height}}};
+    const auto east = x + 1 == width ? 0 : x + 1;
+    const auto west = x == 0 ? width - 1 : x - 1;
+    const auto south = y + 1 == height ? 0 : y + 1;
+    const auto north = y == 0 ? height - 1 : y - 1;
+    return {{{east, y},
+             {west, y},
+             {x, south},
+             {x, north}}};
 }
 
 void to_json(nlohmann::json &json, const Map &map) {
+    // The grid is written as an array of rows of cells.
+    auto grid = nlohmann::json::array();
+    for (dimension_type y = 0; y < map.height; y++) {
+        auto row = nlohmann::json::array();
+        for (dimension_type x = 0; x < map.width; x++) {
+            row.emplace_back(Cell(map.at(x, y)));
+        }
+        grid.emplace_back(std::move(row));
+    }
     json = {FIELD_TO_JSON(height),
             FIELD_TO_JSON(width),
-            FIELD_TO_JSON(grid)};
+            {"grid", grid}};
 }
 
 /**
@@ -53,9 +68,10 @@ std::ostream &operator<<(std::ostream &os, const Map &map) {
     // Output the map dimensions.
     os << map.width << " " << map.height << std::endl;
     // Output the cells one after another.
-    for (const auto &row : map.grid) {
-        for (const auto &cell : row) {
-            os << cell << " ";
+    for (dimension_type y = 0; y < map.height; y++) {
+        const auto *row = map.energy.row(y);
+        for (dimension_type x = 0; x < map.width; x++) {
+            os << row[x] << " ";
         }
         os << std::endl;
     }
@@ -71,16 +87,16 @@ void Map::move_location(Location &location, const Direction &direction) const {
     auto &[x, y] = location;
     switch (direction) {
     case Direction::North:
-        y = (y + height - 1) % height;
+        y = y == 0 ? height - 1 : y - 1;
         break;
     case Direction::South:
-        y = (y + 1) % height;
+        y = y + 1 == height ? 0 : y + 1;
         break;
     case Direction::East:
-        x = (x + 1) % width;
+        x = x + 1 == width ? 0 : x + 1;
         break;
     case Direction::West:
-        x = (x + width - 1) % width;
+        x = x == 0 ? width - 1 : x - 1;
         break;
     case Direction::Still:
         // Don't move
@@ -88,4 +104,17 @@ void Map::move_location(Location &location, const Direction &direction) const {
     }
 }
 
+/**
+ * Get the total energy on the map.
+ * @return The total energy.
+ */
+energy_type Map::total_energy() const {
+    energy_type total = 0;
+    for (dimension_type y = 0; y < height; y++) {
+        const auto *row = energy.row(y);
+        total = std::accumulate(row, row + width, total);
+    }
+    return total;
+}
+
 }
@@ -13,9 +13,23 @@
 
 namespace hlt {
 
-/** The map of cells. */
-class Map final : public Grid<Cell> {
+/**
+ * The map of cells.
+ *
+ * Cells are stored as separate planes of energy, entity, owner and structure, so that scans needing
+ * only one field touch only that field. at() gathers the fields of one cell by reference.
+ */
+class Map final {
 public:
+    dimension_type width{};   /**< The width of the map. */
+    dimension_type height{};  /**< The height of the map. */
+
+    Grid<energy_type> energy;      /**< The energy of each cell. */
+    Grid<Entity::id_type> entity;  /**< The entity on each cell, or Entity::None. */
+    Grid<Player::id_type> owner;   /**< The owner of each cell, or Player::None. */
+    /** The handle of the structure of the owner on each cell, or Player::NO_STRUCTURE. */
+    Grid<Player::structure_type> structure;
+
     /** The factories on this Map. */
     std::vector<Location> factories;
 
@@ -68,7 +82,69 @@ public:
      * @param width The width.
      * @param height The height.
      */
-    Map(dimension_type width, dimension_type height) : Grid(width, height) {}
+    Map(dimension_type width, dimension_type height) :
+            width(width), height(height),
+            energy(width, height),
+            entity(width, height, false, Entity::None),
+            owner(width, height, false, Player::None),
+            structure(width, height, false, Player::NO_STRUCTURE) {}
+
+    /**
+     * Get a reference to the cell at grid coordinates.
+     * @param x The grid x-coordinate.
+     * @param y The grid y-coordinate.
+     * @return Reference to the cell at (x, y).
+     */
+    CellRef at(dimension_type x, dimension_type y) {
+        // All planes share one layout, so one index serves them all.
+        const auto index = energy.index(x, y);
+        return {energy.grid[index], entity.grid[index], owner.grid[index], structure.grid[index]};
+    }
+
+    /**
+     * Get a read-only reference to the cell at grid coordinates.
+     * @param x The grid x-coordinate.
+     * @param y The grid y-coordinate.
+     * @return Reference to the cell at (x, y).
+     */
+    ConstCellRef at(dimension_type x, dimension_type y) const {
+        const auto index = energy.index(x, y);
+        return {energy.grid[index], entity.grid[index], owner.grid[index], structure.grid[index]};
+    }
+
+    /**
+     * Get a reference to the cell at a location.
+     * @param location The location.
+     * @return Reference to the cell at the location.
+     */
+    CellRef at(const Location &location) { return at(location.x, location.y); }
+
+    /**
+     * Get a read-only reference to the cell at a location.
+     * @param location The location.
+     * @return Reference to the cell at the location.
+     */
+    ConstCellRef at(const Location &location) const { return at(location.x, location.y); }
+
+    /**
+     * Get a reference to the cell at a location.
+     * @param location The location.
+     * @return Reference to the cell at the location.
+     */
+    CellRef operator[](const Location &location) { return at(location); }
+
+    /**
+     * Get a read-only reference to the cell at a location.
+     * @param location The location.
+     * @return Reference to the cell at the location.
+     */
+    ConstCellRef operator[](const Location &location) const { return at(location); }
+
+    /**
+     * Get the total energy on the map.
+     * @return The total energy.
+     */
+    energy_type total_energy() const;
 };
 
 }
@@ -16,6 +16,11 @@ namespace hlt {
 struct Player final : public Enumerated<Player> {
     friend class Factory<Player>;
 
+    /** Type of handles to the structures of a player: the factory, then each dropoff in order. */
+    using structure_type = long;
+    static constexpr structure_type FACTORY = 0;       /**< The handle of the factory. */
+    static constexpr structure_type NO_STRUCTURE = -1; /**< Sentinel for cells without a structure. */
+
     std::string name;                    /**< The name of the player. */
     Location factory;                    /**< The factory location of the player. */
     std::vector<Dropoff> dropoffs;       /**< The dropoffs this player owns. */
@@ -23,7 +28,7 @@ struct Player final : public Enumerated<Player> {
     energy_type factory_energy_deposited{}; /**< The amount of energy deposited at the factory so far. */
     energy_type total_energy_deposited{}; /**< The amount of energy collected so far. */
     const std::string command;           /**< The bot command for the player. */
-    id_map<Entity, Location> entities{}; /**< Mapping from entity to location. */
+    flat_id_map<Entity, Location> entities{}; /**< Mapping from entity to location, ordered by entity. */
     bool terminated;                     /**< Whether the player was kicked out of the game. */
     bool can_play = true;                /**< Whether the player has sufficient resources remaining. */
 
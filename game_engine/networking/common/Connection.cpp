@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Connection.hpp"
 #include "NetworkingError.hpp"
 #include "TimeoutError.hpp"
@@ -43,6 +45,49 @@ std::string BaseConnection::read_trailing_input() {
     return result;
 }
 
+/**
+ * Send several buffers along this connection, as one message.
+ * @param buffers The buffers to send, in order.
+ * @throws NetworkingError if the message could not be sent.
+ */
+void BaseConnection::send_buffers(const std::vector<std::string_view> &buffers) {
+    std::string message;
+    for (const auto &buffer : buffers) {
+        message += buffer;
+    }
+    send_string(message);
+}
+
+/**
+ * Send several buffers along this connection, as one message, then read the reply.
+ * The default sends before returning, and reads when the reply is awaited.
+ * @param buffers The buffers to send, in order, which must stay valid until the reply is read.
+ * @param framing The framing of the reply.
+ * @param timeout The timeout of the reply, counted from the message being sent.
+ * @return The reply, valid until the next read from this connection. Holds NetworkingError
+ * if the message could not be sent or the reply could not be read.
+ */
+std::future<Reply> BaseConnection::exchange(const std::vector<std::string_view> &buffers, Framing framing,
+                                            std::chrono::milliseconds timeout) {
+    using namespace std::chrono;
+    try {
+        send_buffers(buffers);
+    } catch (...) {
+        std::promise<Reply> failed;
+        failed.set_exception(std::current_exception());
+        return failed.get_future();
+    }
+    const auto sent = high_resolution_clock::now();
+    // Other bots are sent their messages meanwhile, so only what is left of the timeout remains
+    return std::async(std::launch::deferred, [this, framing, timeout, sent] {
+        const auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now() - sent);
+        const auto remaining = std::max(timeout - elapsed, milliseconds::zero());
+        Reply reply{framing == Framing::Line ? get_string(remaining) : get_record(remaining), sent};
+        reply.received = high_resolution_clock::now();
+        return reply;
+    });
+}
+
 /**
  * Create a new connection using a command.
  * @param command The command.
@@ -70,6 +115,15 @@ Connection &Connections::get(hlt::Player::id_type player) {
     return map[player];
 }
 
+/**
+ * Determine whether a player has a connection.
+ * @param player The player.
+ * @return True if the player has a connection.
+ */
+bool Connections::contains(hlt::Player::id_type player) const {
+    return map.find(player) != map.end();
+}
+
 /**
  * Remove the connection for a player.
  * @param player The player.
@@ -78,4 +132,30 @@ void Connections::remove(hlt::Player::id_type player) {
     map.erase(player);
 }
 
+/**
+ * Take an idle connection to a bot launched with a command.
+ * @param command The command.
+ * @return The connection, or null if there is none.
+ */
+Connection ConnectionPool::take(const std::string &command) {
+    std::lock_guard<std::mutex> guard(mutex);
+    const auto found = idle.find(command);
+    if (found == idle.end()) {
+        return nullptr;
+    }
+    auto connection = std::move(found->second);
+    idle.erase(found);
+    return connection;
+}
+
+/**
+ * Return a connection whose bot awaits its next game.
+ * @param command The command the bot was launched with.
+ * @param connection The connection.
+ */
+void ConnectionPool::put(const std::string &command, Connection connection) {
+    std::lock_guard<std::mutex> guard(mutex);
+    idle.emplace(command, std::move(connection));
+}
+
 }
@@ -1,8 +1,16 @@
 #ifndef CONNECTION_HPP
 #define CONNECTION_HPP
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "Message.hpp"
 #include "NetworkingConfig.hpp"
 #include "Player.hpp"
 
@@ -24,20 +32,61 @@ public:
      */
     virtual void send_string(const std::string &message) = 0;
 
+    /**
+     * Send several buffers along this connection, as one message.
+     * @param buffers The buffers to send, in order.
+     * @throws NetworkingError if the message could not be sent.
+     */
+    virtual void send_buffers(const std::vector<std::string_view> &buffers);
+
+    /**
+     * Get the statistics of the writes to the bot so far.
+     * @return The statistics, empty where the connection does not measure them.
+     */
+    virtual WriteStatistics write_statistics() const { return {}; }
+
+    /**
+     * Send several buffers along this connection, as one message, then read the reply.
+     * The default sends before returning, and reads when the reply is awaited.
+     * @param buffers The buffers to send, in order, which must stay valid until the reply is read.
+     * @param framing The framing of the reply.
+     * @param timeout The timeout of the reply, counted from the message being sent.
+     * @return The reply, valid until the next read from this connection. Holds NetworkingError
+     * if the message could not be sent or the reply could not be read.
+     */
+    virtual std::future<Reply> exchange(const std::vector<std::string_view> &buffers, Framing framing,
+                                        std::chrono::milliseconds timeout);
+
     /**
      * Get a string from this connection with configured timeout.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    virtual std::string get_string() = 0;
+    virtual std::string_view get_string() = 0;
 
     /**
      * Get a string from this connection.
      * @param timeout The timeout to use.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    virtual std::string get_string(std::chrono::milliseconds timeout) = 0;
+    virtual std::string_view get_string(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this
+     * connection with configured timeout.
+     * @return The record, without its length, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    virtual std::string_view get_record() = 0;
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this connection.
+     * @param timeout The timeout to use.
+     * @return The record, without its length, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    virtual std::string_view get_record(std::chrono::milliseconds timeout) = 0;
 
     /**
      * Read any remaining input from the pipe.
@@ -106,6 +155,13 @@ public:
      */
     Connection &get(hlt::Player::id_type player);
 
+    /**
+     * Determine whether a player has a connection.
+     * @param player The player.
+     * @return True if the player has a connection.
+     */
+    bool contains(hlt::Player::id_type player) const;
+
     /**
      * Remove the connection for a player.
      * @param player The player.
@@ -113,6 +169,30 @@ public:
     void remove(hlt::Player::id_type player);
 };
 
+/**
+ * Idle connections to bots that play several games, kept between the games of a batch.
+ * Safe to use from multiple threads.
+ */
+class ConnectionPool final {
+    std::mutex mutex;                                      /**< Guards the idle connections. */
+    std::unordered_multimap<std::string, Connection> idle; /**< The idle connections, by bot command. */
+
+public:
+    /**
+     * Take an idle connection to a bot launched with a command.
+     * @param command The command.
+     * @return The connection, or null if there is none.
+     */
+    Connection take(const std::string &command);
+
+    /**
+     * Return a connection whose bot awaits its next game.
+     * @param command The command the bot was launched with.
+     * @param connection The connection.
+     */
+    void put(const std::string &command, Connection connection);
+};
+
 }
 
 #endif // CONNECTION_HPP
@@ -0,0 +1,32 @@
+#ifndef MESSAGE_HPP
+#define MESSAGE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+namespace net {
+
+/** The ways in which the messages of a bot are delimited. */
+enum class Framing {
+    Line,   /**< Terminated by a newline. */
+    Record, /**< Prefixed by their length, as a 32-bit little-endian integer. */
+};
+
+/** The reply of a bot to a message sent to it. */
+struct Reply {
+    std::string_view message;                                  /**< The reply, valid until the next read from the bot. */
+    std::chrono::high_resolution_clock::time_point sent{};     /**< When the message to the bot was sent in full. */
+    std::chrono::high_resolution_clock::time_point received{}; /**< When the reply arrived. */
+};
+
+/** Statistics of the writes to a bot. */
+struct WriteStatistics {
+    size_t bytes_sent{};                      /**< The number of bytes sent. */
+    size_t blocked_writes{};                  /**< The number of times a write waited for the bot to read. */
+    std::chrono::microseconds blocked_time{}; /**< The time spent waiting for the bot to read. */
+};
+
+}
+
+#endif // MESSAGE_HPP
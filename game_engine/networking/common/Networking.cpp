@@ -1,5 +1,9 @@
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
 
 #include "Command.hpp"
 #include "Halite.hpp"
@@ -13,6 +17,43 @@ using namespace hlt;
 
 /** Maximum permissible length for user name in characters, truncated past this. */
 constexpr auto NAME_MAX_LENGTH = 30;
+/** The constant offering the binary protocol, whose value is the version offered. */
+constexpr auto BINARY_PROTOCOL_KEY = "binary_protocol";
+/** The version of the binary protocol. */
+constexpr auto BINARY_PROTOCOL_VERSION = 1;
+/** The constant offering to keep the bot for further games, whose value is the version offered. */
+constexpr auto MULTI_GAME_KEY = "multi_game";
+/** The version of the multi-game protocol. */
+constexpr auto MULTI_GAME_VERSION = 1;
+/** The turn number that tells a bot playing several games that the game is over. */
+constexpr auto GAME_OVER_TURN = 0;
+
+/** The number of bytes of trailing binary input shown in the logs. */
+constexpr auto TRAILING_BYTES_SHOWN = 32;
+
+/**
+ * Summarize binary input for the logs, as its size and its first bytes in hexadecimal.
+ * @param input The input.
+ * @return The summary.
+ */
+static std::string hex_summary(std::string_view input) {
+    static constexpr auto hex_digits = "0123456789abcdef";
+    auto summary = "(" + std::to_string(input.size()) + " trailing bytes";
+    const auto shown = std::min<size_t>(input.size(), TRAILING_BYTES_SHOWN);
+    if (shown > 0) {
+        summary += ':';
+    }
+    for (size_t index = 0; index < shown; index++) {
+        const auto byte = static_cast<unsigned char>(input[index]);
+        summary += ' ';
+        summary += hex_digits[byte >> 4];
+        summary += hex_digits[byte & 0xF];
+    }
+    if (shown < input.size()) {
+        summary += " ...";
+    }
+    return summary + ")\n";
+}
 
 /**
  * Handle a player communication error.
@@ -22,7 +63,16 @@ constexpr auto NAME_MAX_LENGTH = 30;
 void Networking::handle_player_error(Player::id_type player, std::string received_input) {
     auto &connection = connections.get(player);
     try {
-        received_input += connection->read_trailing_input();
+        auto trailing_input = connection->read_trailing_input();
+        // Binary input is not readable in the logs, so it is only summarized.
+        if (const auto protocol = protocols.find(player); protocol != protocols.end()
+                                                          && protocol->second == Protocol::Binary) {
+            if (!trailing_input.empty()) {
+                received_input += hex_summary(trailing_input);
+            }
+        } else {
+            received_input += trailing_input;
+        }
     } catch (...) {
         // Ignore any exceptions from the read attempt.
     }
@@ -49,33 +99,123 @@ void Networking::handle_player_error(Player::id_type player, std::string receive
 }
 
 /**
- * Launch the bot for a player and register their connection.
+ * Append the decimal form of an integer to a message.
+ * @param message The message.
+ * @param value The integer.
+ */
+template<class Integer>
+static void append_number(std::string &message, Integer value) {
+    std::array<char, std::numeric_limits<Integer>::digits10 + 2> digits{};
+    const auto result = std::to_chars(digits.begin(), digits.end(), value);
+    message.append(digits.begin(), result.ptr);
+}
+
+/**
+ * Append a line of space-separated integers to a message.
+ * @param message The message.
+ * @param first The first integer.
+ * @param rest The remaining integers.
+ */
+template<class Integer, class... Integers>
+static void append_line(std::string &message, Integer first, Integers... rest) {
+    append_number(message, first);
+    ((message += ' ', append_number(message, rest)), ...);
+    message += '\n';
+}
+
+/**
+ * Append 32-bit little-endian integers to a message.
+ * @param message The message.
+ * @param values The integers, which must fit in 32 bits.
+ */
+template<class... Integers>
+static void append_binary(std::string &message, Integers... values) {
+    const auto append_value = [&message](auto value) {
+        const auto bits = static_cast<std::uint32_t>(value);
+        message += static_cast<char>(bits & 0xFF);
+        message += static_cast<char>((bits >> 8) & 0xFF);
+        message += static_cast<char>((bits >> 16) & 0xFF);
+        message += static_cast<char>((bits >> 24) & 0xFF);
+    };
+    (append_value(values), ...);
+}
+
+/**
+ * Remove a suffix from a string, if the string ends with it.
+ * @param text The string.
+ * @param suffix The suffix.
+ * @return True if the suffix was removed.
+ */
+static bool remove_suffix(std::string_view &text, std::string_view suffix) {
+    if (text.size() < suffix.size() || text.substr(text.size() - suffix.size()) != suffix) {
+        return false;
+    }
+    text.remove_suffix(suffix.size());
+    return true;
+}
+
+/**
+ * Launch the bot for a player and register their connection, reusing an idle bot
+ * launched with the same command if the configuration has a pool of them.
  *
  * @param player The player.
  */
 void Networking::connect_player(hlt::Player &player) {
-    connections.add(player.id, connection_factory.new_connection(player.command));
+    auto connection = config.pool != nullptr ? config.pool->take(player.command) : nullptr;
+    if (connection) {
+        Logging::log("Reusing the bot of an earlier game", Logging::Level::Info, player.id);
+    } else {
+        connection = connection_factory.new_connection(player.command);
+    }
+    connections.add(player.id, std::move(connection));
+    command_parsers[player.id];
+    protocols[player.id] = Protocol::Text;
+    multi_game[player.id] = false;
+    exchanges[player.id];
 }
 
 /**
- * Launch the bot for a player, send the initial game information to the player, and update its name.
- * Safe to invoke from multiple threads on different players.
+ * Start an exchange with a player, which completes without a thread waiting on it.
  *
- * @param player The player to communicate with.
+ * @param player The player.
+ * @param message The shared parts of the message, kept until the reply.
+ * @param buffers The message, in buffers sent in order.
+ * @param framing The framing of the reply.
+ * @param timeout The timeout of the reply.
  */
-void Networking::initialize_player(Player &player) {
-    std::stringstream message_stream;
-    Logging::log("Sending init message", Logging::Level::Debug, player.id);
+void Networking::start_exchange(const Player &player, std::shared_ptr<const void> message,
+                                const std::vector<std::string_view> &buffers, Framing framing,
+                                std::chrono::milliseconds timeout) {
+    auto &exchange = exchanges.at(player.id);
+    exchange.message = std::move(message);
+    exchange.bytes_sent = 0;
+    for (const auto &buffer : buffers) {
+        exchange.bytes_sent += buffer.size();
+    }
+    exchange.started = std::chrono::high_resolution_clock::now();
+    exchange.reply = connections.get(player.id)->exchange(buffers, framing, timeout);
+}
+
+/**
+ * Encode the parts of the initial game information that are the same for every player.
+ *
+ * @return The encoded parts.
+ */
+std::shared_ptr<const InitMessage> Networking::encode_init() const {
+    auto init = std::make_shared<InitMessage>();
     // Send the game constants
     nlohmann::json constants = Constants::get();
     constants["game_seed"] = game.replay.map_generator_seed;
     constants["map_width"] = game.map.width;
     constants["map_height"] = game.map.height;
-    message_stream << constants.dump() << std::endl;
+    constants[BINARY_PROTOCOL_KEY] = BINARY_PROTOCOL_VERSION;
+    // Bots can only be kept for further games when there is a pool to keep them in
+    if (config.pool != nullptr) {
+        constants[MULTI_GAME_KEY] = MULTI_GAME_VERSION;
+    }
+    init->constants = constants.dump() + "\n";
 
-    // Send the number of players and player ID
-    message_stream << game.store.players.size()
-                   << " " << player.id << std::endl;
+    std::ostringstream message_stream;
     // Send each player's ID and factory location
     for (const auto &[player_id, other_player] : game.store.players) {
         message_stream << player_id
@@ -84,19 +224,63 @@ void Networking::initialize_player(Player &player) {
     }
     // Send the map
     message_stream << game.map;
+    init->players_and_map = message_stream.str();
+    return init;
+}
+
+/**
+ * Start sending the initial game information to the player. Returns without waiting
+ * for the bot, so that every player can be sent theirs before any reply is awaited.
+ *
+ * @param player The player to communicate with.
+ * @param init The shared parts of the initial game information, from encode_init.
+ */
+void Networking::send_init(const Player &player, std::shared_ptr<const InitMessage> init) {
+    Logging::log("Sending init message", Logging::Level::Debug, player.id);
+    // Send the number of players and player ID between the shared parts
+    auto &player_line = exchanges.at(player.id).player_line;
+    player_line.clear();
+    append_line(player_line, game.store.players.size(), player.id.value);
+    static constexpr auto INIT_TIMEOUT = std::chrono::seconds(30);
+    const std::vector<std::string_view> buffers{init->constants, player_line, init->players_and_map};
+    start_exchange(player, std::move(init), buffers, Framing::Line, INIT_TIMEOUT);
+}
 
+/**
+ * Wait for the reply of the player to the initial game information, and update its name.
+ *
+ * @param player The player, who was sent the initial game information by send_init.
+ */
+void Networking::receive_name(Player &player) {
+    auto &exchange = exchanges.at(player.id);
     try {
-        connections.get(player.id)->send_string(message_stream.str());
-        Logging::log("Init message sent", Logging::Level::Debug, player.id);
         // Receive a name from the player.
-        static constexpr auto INIT_TIMEOUT = std::chrono::seconds(30);
-        auto name = connections.get(player.id)->get_string(INIT_TIMEOUT).substr(0, NAME_MAX_LENGTH);
+        auto reply = exchange.reply.get().message;
+        exchange.message.reset();
+        // Bots accept offers by following their name with them, in any order
+        static const auto binary_acceptance = std::string(" ") + BINARY_PROTOCOL_KEY + "="
+                                              + std::to_string(BINARY_PROTOCOL_VERSION);
+        static const auto multi_game_acceptance = std::string(" ") + MULTI_GAME_KEY + "="
+                                                  + std::to_string(MULTI_GAME_VERSION);
+        while (true) {
+            if (remove_suffix(reply, binary_acceptance)) {
+                protocols.at(player.id) = Protocol::Binary;
+                Logging::log("Binary protocol accepted", Logging::Level::Debug, player.id);
+            } else if (config.pool != nullptr && remove_suffix(reply, multi_game_acceptance)) {
+                multi_game.at(player.id) = true;
+                Logging::log("Multiple games accepted", Logging::Level::Debug, player.id);
+            } else {
+                break;
+            }
+        }
+        std::string name(reply.substr(0, NAME_MAX_LENGTH));
         // On Windows, we get the \r character in names.
         name.erase(std::remove(name.begin(), name.end(), '\r'), name.end());
         player.name = name;
         Logging::log("Init message received, name: " + player.name,
                      Logging::Level::Debug, player.id);
     } catch (const BotError &e) {
+        exchange.message.reset();
         Logging::log("Failed to initialize", Logging::Level::Error, player.id);
         game.logs.log(player.id, e.what(), PlayerLog::Level::Error);
         handle_player_error(player.id);
@@ -106,58 +290,151 @@ void Networking::initialize_player(Player &player) {
 }
 
 /**
- * Handle the networking for a single frame, obtaining commands from the player if there are any.
- * Safe to invoke from multiple threads on different players.
+ * Encode the state of the current turn, which is sent to every player, in the protocols in use.
  *
- * @param player The player to communicate with.
- * @return The commands from the player.
+ * @return The encoded frame.
  */
-std::vector<std::unique_ptr<Command>> Networking::handle_frame(Player &player) {
-    std::stringstream message_stream;
-    // Send the turn number, then each player in the game.
-    message_stream << game.turn_number << std::endl;
-    for (const auto &[_, other_player] : game.store.players) {
-        message_stream << other_player;
-        // Output a list of entities.
-        for (const auto &[entity_id, location] : other_player.entities) {
-            const auto entity_iterator = game.store.entities.find(entity_id);
-            message_stream << entity_id
-                           << " " << location
-                           << " " << entity_iterator->second.energy
-                           << std::endl;
+std::shared_ptr<const Frame> Networking::encode_frame() const {
+    // Roughly the widest line of each kind
+    static constexpr auto PLAYER_LINE_LENGTH = 32;
+    static constexpr auto ENTITY_LINE_LENGTH = 24;
+    static constexpr auto CELL_LINE_LENGTH = 16;
+    // The exact size of each binary record, and of the length before them
+    static constexpr auto INTEGER_SIZE = 4;
+    static constexpr auto PLAYER_SIZE = 4 * INTEGER_SIZE;
+    static constexpr auto ENTITY_SIZE = 4 * INTEGER_SIZE;
+    static constexpr auto DROPOFF_SIZE = 3 * INTEGER_SIZE;
+    static constexpr auto CELL_SIZE = 3 * INTEGER_SIZE;
+    const auto &store = game.store;
+    auto frame = std::make_shared<Frame>();
+    bool text = false;
+    bool binary = false;
+    for (const auto &[player_id, player] : store.players) {
+        if (const auto protocol = protocols.find(player_id); !player.terminated && protocol != protocols.end()) {
+            if (protocol->second == Protocol::Binary) {
+                binary = true;
+            } else {
+                text = true;
+            }
+        }
+    }
+    if (text) {
+        auto &message = frame->text;
+        message.reserve(PLAYER_LINE_LENGTH * (store.players.size() + 1)
+                        + ENTITY_LINE_LENGTH * store.entities.size()
+                        + CELL_LINE_LENGTH * (store.changed_cells.size() + 1));
+        // Send the turn number, then each player in the game.
+        append_line(message, game.turn_number);
+        for (const auto &[player_id, player] : store.players) {
+            append_line(message, player_id.value, player.entities.size(), player.dropoffs.size(), player.energy);
+            // Output a list of entities.
+            for (const auto &[entity_id, location] : player.entities) {
+                append_line(message, entity_id.value, location.x, location.y, store.get_entity(entity_id).energy);
+            }
+            // Output a list of dropoffs.
+            for (const auto &dropoff : player.dropoffs) {
+                append_line(message, dropoff.id.value, dropoff.location.x, dropoff.location.y);
+            }
         }
-        // Output a list of dropoffs.
-        for (const auto &dropoff : other_player.dropoffs) {
-            message_stream << dropoff << std::endl;
+        // Send the changed cells.
+        append_line(message, store.changed_cells.size());
+        for (const auto &location : store.changed_cells) {
+            append_line(message, location.x, location.y, game.map.energy.at(location));
         }
     }
-    // Send the changed cells.
-    message_stream << game.store.changed_cells.size() << std::endl;
-    for (const auto &location : game.store.changed_cells) {
-        message_stream << location << " " << game.map.at(location).energy << std::endl;
+    if (binary) {
+        // The same fields in the same order, each a 32-bit integer, after the length of the rest
+        auto &message = frame->binary;
+        size_t dropoffs = 0;
+        for (const auto &[player_id, player] : store.players) {
+            dropoffs += player.dropoffs.size();
+        }
+        const auto length = INTEGER_SIZE + PLAYER_SIZE * store.players.size()
+                            + ENTITY_SIZE * store.entities.size() + DROPOFF_SIZE * dropoffs
+                            + INTEGER_SIZE + CELL_SIZE * store.changed_cells.size();
+        message.reserve(INTEGER_SIZE + length);
+        append_binary(message, length, game.turn_number);
+        for (const auto &[player_id, player] : store.players) {
+            append_binary(message, player_id.value, player.entities.size(), player.dropoffs.size(), player.energy);
+            for (const auto &[entity_id, location] : player.entities) {
+                append_binary(message, entity_id.value, location.x, location.y, store.get_entity(entity_id).energy);
+            }
+            for (const auto &dropoff : player.dropoffs) {
+                append_binary(message, dropoff.id.value, dropoff.location.x, dropoff.location.y);
+            }
+        }
+        append_binary(message, store.changed_cells.size());
+        for (const auto &location : store.changed_cells) {
+            append_binary(message, location.x, location.y, game.map.energy.at(location));
+        }
     }
+    return frame;
+}
+
+/**
+ * Start sending the frame of the turn to the player. Returns without waiting for the
+ * bot, so that every player can be sent the frame before any commands are awaited.
+ *
+ * @param player The player to communicate with.
+ * @param frame The frame of the turn, from encode_frame.
+ */
+void Networking::send_frame(const Player &player, std::shared_ptr<const Frame> frame) {
+    const auto binary = protocols.at(player.id) == Protocol::Binary;
+    const std::string_view message = binary ? frame->binary : frame->text;
+    start_exchange(player, std::move(frame), {message}, binary ? Framing::Record : Framing::Line, config.timeout);
+}
 
-    std::vector<std::unique_ptr<Command>> commands;
-    std::string received_input;
+/**
+ * Wait for the commands of the player for the turn.
+ *
+ * @param player The player, who was sent the frame of the turn by send_frame.
+ * @return The commands from the player.
+ */
+std::vector<Command> Networking::receive_commands(Player &player) {
+    std::vector<Command> commands;
+    const auto binary = protocols.at(player.id) == Protocol::Binary;
+    // A view of the input, which stays valid until the next read from the bot
+    std::string_view received_input;
+    auto &exchange = exchanges.at(player.id);
+    auto &statistics = game.game_statistics.player_statistics.at(player.id.value);
+    const auto record_turn = [&](auto response_time, long long bytes_received) {
+        statistics.turn_response_times.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(response_time).count());
+        statistics.turn_bytes_sent.push_back(static_cast<long long>(exchange.bytes_sent));
+        statistics.turn_bytes_received.push_back(bytes_received);
+    };
+    bool replied = false;
     try {
-        connections.get(player.id)->send_string(message_stream.str());
-        Logging::log("Turn info sent", Logging::Level::Debug, player.id);
         // Get commands from the player.
-        received_input = connections.get(player.id)->get_string();
-        std::istringstream command_stream(received_input);
-        std::unique_ptr<Command> command;
-        while (command_stream >> command) {
-            commands.push_back(std::move(command));
+        const auto reply = exchange.reply.get();
+        exchange.message.reset();
+        replied = true;
+        received_input = reply.message;
+        record_turn(reply.received - reply.sent,
+                    static_cast<long long>(received_input.size() + (binary ? sizeof(std::uint32_t) : 1)));
+        auto &parser = command_parsers.at(player.id);
+        if (binary) {
+            // Commands are held by value, so the whole turn is one contiguous copy of the parse.
+            commands = parser.parse_binary(received_input);
+        } else {
+            commands = parser.parse(received_input);
         }
-        command_stream >> command;
         Logging::log([number = commands.size()]() {
             return "Received " + std::to_string(number) + " commands";
         }, Logging::Level::Debug, player.id);
     } catch (const BotError &e) {
+        exchange.message.reset();
+        // Turns that fail are recorded too, with the time the bot was waited for, so slow bots count.
+        if (!replied) {
+            record_turn(std::chrono::high_resolution_clock::now() - exchange.started, 0);
+        }
+        statistics.failed_turns++;
         Logging::log("Communication failed", Logging::Level::Error, player.id);
         game.logs.log(player.id, e.what(), PlayerLog::Level::Error);
-        received_input += '\n';
-        handle_player_error(player.id, received_input);
+        // Binary input is not readable in the logs, so only its size is given.
+        handle_player_error(player.id, binary
+                                       ? "(" + std::to_string(received_input.size()) + " byte binary record)\n"
+                                       : std::string(received_input) + '\n');
         throw;
     }
 
@@ -170,11 +447,39 @@ std::vector<std::unique_ptr<Command>> Networking::handle_frame(Player &player) {
  * @param player The player whose connection to end.
  */
 void Networking::kill_player(const hlt::Player &player) {
+    // Bots that failed to launch, and players simulated in process, have no connection.
+    if (!connections.contains(player.id)) {
+        return;
+    }
     const auto errors = connections.get(player.id)->get_errors();
     if (!errors.empty()) {
         game.logs.log(player.id, "Bot error output was:");
         game.logs.log(player.id, errors);
     }
+    const auto statistics = connections.get(player.id)->write_statistics();
+    Logging::log([statistics]() {
+        return "Sent " + std::to_string(statistics.bytes_sent) + " bytes, blocked "
+               + std::to_string(statistics.blocked_writes) + " times for "
+               + std::to_string(statistics.blocked_time.count() / 1000) + " ms waiting for the bot to read";
+    }, statistics.blocked_writes > 0 ? Logging::Level::Info : Logging::Level::Debug, player.id);
+    // A bot that failed this game is not trusted with the next one
+    if (config.pool != nullptr && !player.terminated && multi_game.at(player.id)) {
+        auto &connection = connections.get(player.id);
+        std::string game_over;
+        if (protocols.at(player.id) == Protocol::Binary) {
+            append_binary(game_over, sizeof(std::uint32_t), GAME_OVER_TURN);
+        } else {
+            append_line(game_over, GAME_OVER_TURN);
+        }
+        try {
+            connection->send_string(game_over);
+            config.pool->put(player.command, std::move(connection));
+            Logging::log("Bot kept for the next game", Logging::Level::Debug, player.id);
+        } catch (const BotError &e) {
+            Logging::log(std::string("Bot could not be kept for the next game: ") + e.what(),
+                         Logging::Level::Warning, player.id);
+        }
+    }
     connections.remove(player.id);
 }
 
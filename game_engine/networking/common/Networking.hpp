@@ -1,12 +1,16 @@
 #ifndef NETWORKING_H
 #define NETWORKING_H
 
+#include <chrono>
+#include <future>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
 
 #include "Command.hpp"
+#include "CommandParser.hpp"
 #include "Connection.hpp"
 #include "NetworkingConfig.hpp"
 #include "Player.hpp"
@@ -25,6 +29,33 @@ class Halite;
 
 namespace net {
 
+/** The parts of the initial game information that are the same for every player. */
+struct InitMessage {
+    std::string constants;       /**< The game constants, sent first. */
+    std::string players_and_map; /**< The factory of each player and the map, sent after the player's own ID. */
+};
+
+/** The protocols in which bots may be sent turns and send commands. */
+enum class Protocol {
+    Text,   /**< Lines of decimal integers, and lines of commands. */
+    Binary, /**< Length-prefixed records of little-endian integers, offered at init. */
+};
+
+/** The state of a turn, encoded once for all players in each protocol they use. */
+struct Frame {
+    std::string text;   /**< The frame in the text protocol. */
+    std::string binary; /**< The frame in the binary protocol, with its length. */
+};
+
+/** A message sent to a bot whose reply is awaited. */
+struct PendingExchange {
+    std::future<Reply> reply;                                /**< The reply of the bot. */
+    std::shared_ptr<const void> message;                     /**< The shared parts of the message, kept until the reply. */
+    std::string player_line;                                 /**< The part of the message for the player alone. */
+    size_t bytes_sent{};                                     /**< The size of the message. */
+    std::chrono::high_resolution_clock::time_point started{}; /**< When the message started to be sent. */
+};
+
 /** Networking support suite for Halite. */
 class Networking final {
 private:
@@ -32,38 +63,91 @@ private:
     Connections connections;      /**< The current network connections. */
     NetworkingConfig config;      /**< The networking configuration. */
     hlt::Halite &game;            /**< The current game. */
+    /** The command parser of each player, reused every turn. */
+    id_map<hlt::Player, hlt::CommandParser> command_parsers;
+    /** The protocol of each player, chosen by the bot at init. */
+    id_map<hlt::Player, Protocol> protocols;
+    /** Whether the bot of each player accepted to play several games, at init. */
+    id_map<hlt::Player, bool> multi_game;
+    /** The message each player was last sent, whose reply is awaited. */
+    id_map<hlt::Player, PendingExchange> exchanges;
+
+    /**
+     * Start an exchange with a player, which completes without a thread waiting on it.
+     *
+     * @param player The player.
+     * @param message The shared parts of the message, kept until the reply.
+     * @param buffers The message, in buffers sent in order.
+     * @param framing The framing of the reply.
+     * @param timeout The timeout of the reply.
+     */
+    void start_exchange(const hlt::Player &player, std::shared_ptr<const void> message,
+                        const std::vector<std::string_view> &buffers, Framing framing,
+                        std::chrono::milliseconds timeout);
 
 public:
     /**
-     * Launch the bot for a player and register their connection.
+     * Launch the bot for a player and register their connection, reusing an idle bot
+     * launched with the same command if the configuration has a pool of them.
      *
      * @param player The player.
      */
     void connect_player(hlt::Player &player);
 
     /**
-     * Send the initial game information to the player, and update its name.
-     * Safe to invoke from multiple threads on different players.
+     * Encode the parts of the initial game information that are the same for every player.
+     *
+     * @return The encoded parts.
+     */
+    std::shared_ptr<const InitMessage> encode_init() const;
+
+    /**
+     * Start sending the initial game information to the player. Returns without waiting
+     * for the bot, so that every player can be sent theirs before any reply is awaited.
      *
      * @param player The player to communicate with.
+     * @param init The shared parts of the initial game information, from encode_init.
      */
-    void initialize_player(hlt::Player &player);
+    void send_init(const hlt::Player &player, std::shared_ptr<const InitMessage> init);
 
     /**
-     * Kill a player connection.
+     * Wait for the reply of the player to the initial game information, and update its name.
+     *
+     * @param player The player, who was sent the initial game information by send_init.
+     */
+    void receive_name(hlt::Player &player);
+
+    /**
+     * Kill a player connection. A bot that accepted to play several games and is still in
+     * the game is instead told that the game is over, and returned to the pool.
      *
      * @param player The player whose connection to end.
      */
     void kill_player(const hlt::Player &player);
 
     /**
-     * Handle the networking for a single frame, obtaining commands from the player if there are any.
-     * Safe to invoke from multiple threads on different players.
+     * Encode the state of the current turn, which is sent to every player, in the protocols in use.
+     *
+     * @return The encoded frame.
+     */
+    std::shared_ptr<const Frame> encode_frame() const;
+
+    /**
+     * Start sending the frame of the turn to the player. Returns without waiting for the
+     * bot, so that every player can be sent the frame before any commands are awaited.
      *
      * @param player The player to communicate with.
+     * @param frame The frame of the turn, from encode_frame.
+     */
+    void send_frame(const hlt::Player &player, std::shared_ptr<const Frame> frame);
+
+    /**
+     * Wait for the commands of the player for the turn.
+     *
+     * @param player The player, who was sent the frame of the turn by send_frame.
      * @return The commands from the player.
      */
-    std::vector<std::unique_ptr<hlt::Command>> handle_frame(hlt::Player &player);
+    std::vector<hlt::Command> receive_commands(hlt::Player &player);
 
     /**
      * Handle a player communication error.
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cstring>
+
+#include "LineBuffer.hpp"
+
+namespace net {
+
+/** Double the capacity, moving the unread bytes to the start of the ring. */
+void LineBuffer::grow() {
+    std::vector<char> grown(storage.size() * 2);
+    const auto first = std::min(size, storage.size() - head);
+    std::memcpy(grown.data(), storage.data() + head, first);
+    std::memcpy(grown.data() + first, storage.data(), size - first);
+    storage = std::move(grown);
+    head = 0;
+}
+
+/**
+ * Get the free space following the unread bytes, growing the ring if it is full.
+ * @return The start and length of the space, which is contiguous and never empty.
+ */
+std::pair<char *, size_t> LineBuffer::reserve() {
+    if (size == storage.size()) {
+        grow();
+    }
+    const auto capacity = storage.size();
+    const auto tail = (head + size) & (capacity - 1);
+    // The space runs to the end of the ring, unless the unread bytes already wrap
+    const auto end = head + size < capacity ? capacity : head;
+    return {storage.data() + tail, end - tail};
+}
+
+/**
+ * Add bytes written to the space given by reserve.
+ * @param length The number of bytes written.
+ */
+void LineBuffer::commit(size_t length) {
+    size += length;
+}
+
+/**
+ * Add bytes read from the bot.
+ * @param data The bytes.
+ * @param length The number of bytes.
+ */
+void LineBuffer::append(const char *data, size_t length) {
+    while (length > 0) {
+        const auto [space, space_length] = reserve();
+        const auto copied = std::min(length, space_length);
+        std::memcpy(space, data, copied);
+        commit(copied);
+        data += copied;
+        length -= copied;
+    }
+}
+
+/**
+ * View unread bytes, copying them only if they wrap around the ring.
+ * @param[out] message The view.
+ * @param start The offset of the bytes from the first unread byte.
+ * @param length The number of bytes.
+ */
+void LineBuffer::view(std::string_view &message, size_t start, size_t length) {
+    const auto capacity = storage.size();
+    const auto offset = (head + start) & (capacity - 1);
+    const auto first = std::min(length, capacity - offset);
+    if (first == length) {
+        message = std::string_view(storage.data() + offset, length);
+    } else {
+        wrapped.assign(storage.data() + offset, first);
+        wrapped.append(storage.data(), length - first);
+        message = wrapped;
+    }
+}
+
+/**
+ * Drop unread bytes.
+ * @param length The number of bytes.
+ */
+void LineBuffer::drop(size_t length) {
+    // An empty ring restarts at the front, to read in larger pieces
+    size -= length;
+    head = size == 0 ? 0 : (head + length) & (storage.size() - 1);
+    scanned = 0;
+}
+
+/**
+ * Take the oldest complete line, if any.
+ * @param[out] message The line.
+ * @return True if a line was taken.
+ */
+bool LineBuffer::pop_line(std::string_view &message) {
+    const auto first = std::min(size, storage.size() - head);
+    // Only search the bytes that arrived since the last search, in at most two pieces
+    size_t length = size;
+    if (scanned < first) {
+        const auto start = storage.data() + head + scanned;
+        if (const auto newline = std::memchr(start, '\n', first - scanned)) {
+            length = static_cast<size_t>(static_cast<const char *>(newline) - (storage.data() + head));
+        }
+    }
+    if (length == size && size > first) {
+        const auto from = std::max(scanned, first) - first;
+        const auto start = storage.data() + from;
+        if (const auto newline = std::memchr(start, '\n', size - first - from)) {
+            length = first + static_cast<size_t>(static_cast<const char *>(newline) - storage.data());
+        }
+    }
+    if (length == size) {
+        scanned = size;
+        return false;
+    }
+    view(message, 0, length);
+    drop(length + 1);
+    return true;
+}
+
+/**
+ * Take the oldest complete record, if any.
+ * @param[out] message The record.
+ * @return True if a record was taken.
+ */
+bool LineBuffer::pop_record(std::string_view &message) {
+    static constexpr size_t LENGTH_SIZE = 4;
+    if (size < LENGTH_SIZE) {
+        return false;
+    }
+    std::string_view prefix;
+    view(prefix, 0, LENGTH_SIZE);
+    size_t length = 0;
+    for (size_t i = 0; i < LENGTH_SIZE; i++) {
+        length |= static_cast<size_t>(static_cast<unsigned char>(prefix[i])) << (8 * i);
+    }
+    if (size - LENGTH_SIZE < length) {
+        return false;
+    }
+    view(message, LENGTH_SIZE, length);
+    drop(LENGTH_SIZE + length);
+    return true;
+}
+
+/**
+ * Take the oldest complete message, if any.
+ * @param[out] message The message, without its newline or length, valid until the next
+ * call to any member other than partial.
+ * @param framing The framing of the message.
+ * @return True if a message was taken.
+ */
+bool LineBuffer::pop(std::string_view &message, Framing framing) {
+    return framing == Framing::Line ? pop_line(message) : pop_record(message);
+}
+
+/**
+ * Get the input not yet taken as a message, which is the partial message once pop fails.
+ * @return The input.
+ */
+std::string LineBuffer::partial() const {
+    const auto first = std::min(size, storage.size() - head);
+    std::string input(storage.data() + head, first);
+    input.append(storage.data(), size - first);
+    return input;
+}
+
+}
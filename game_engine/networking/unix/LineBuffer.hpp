@@ -0,0 +1,102 @@
+#ifndef LINEBUFFER_HPP
+#define LINEBUFFER_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Message.hpp"
+
+namespace net {
+
+/**
+ * Splits the bytes read from a bot into messages, newline-terminated or length-prefixed.
+ *
+ * Bytes are read straight into a ring buffer, and messages are handed out as views of
+ * it, so that a message is only copied if it wraps around the end of the ring. The ring
+ * doubles whenever it fills, so it grows to the longest message the bot sends.
+ */
+class LineBuffer final {
+    /** The initial capacity, that of a default pipe. */
+    static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+
+    std::vector<char> storage; /**< The ring, whose size is a power of two. */
+    size_t head{};             /**< The offset of the first unread byte. */
+    size_t size{};             /**< The number of unread bytes. */
+    size_t scanned{};          /**< The number of unread bytes known to hold no newline. */
+    std::string wrapped;       /**< The last message taken, if it wrapped around the ring. */
+
+    /** Double the capacity, moving the unread bytes to the start of the ring. */
+    void grow();
+
+    /**
+     * View unread bytes, copying them only if they wrap around the ring.
+     * @param[out] message The view.
+     * @param start The offset of the bytes from the first unread byte.
+     * @param length The number of bytes.
+     */
+    void view(std::string_view &message, size_t start, size_t length);
+
+    /**
+     * Drop unread bytes.
+     * @param length The number of bytes.
+     */
+    void drop(size_t length);
+
+    /**
+     * Take the oldest complete line, if any.
+     * @param[out] message The line.
+     * @return True if a line was taken.
+     */
+    bool pop_line(std::string_view &message);
+
+    /**
+     * Take the oldest complete record, if any.
+     * @param[out] message The record.
+     * @return True if a record was taken.
+     */
+    bool pop_record(std::string_view &message);
+
+public:
+    /** Construct an empty LineBuffer. */
+    LineBuffer() : storage(INITIAL_CAPACITY) {}
+
+    /**
+     * Get the free space following the unread bytes, growing the ring if it is full.
+     * @return The start and length of the space, which is contiguous and never empty.
+     */
+    std::pair<char *, size_t> reserve();
+
+    /**
+     * Add bytes written to the space given by reserve.
+     * @param length The number of bytes written.
+     */
+    void commit(size_t length);
+
+    /**
+     * Add bytes read from the bot.
+     * @param data The bytes.
+     * @param length The number of bytes.
+     */
+    void append(const char *data, size_t length);
+
+    /**
+     * Take the oldest complete message, if any.
+     * @param[out] message The message, without its newline or length, valid until the next
+     * call to any member other than partial.
+     * @param framing The framing of the message.
+     * @return True if a message was taken.
+     */
+    bool pop(std::string_view &message, Framing framing = Framing::Line);
+
+    /**
+     * Get the input not yet taken as a message, which is the partial message once pop fails.
+     * @return The input.
+     */
+    std::string partial() const;
+};
+
+}
+
+#endif // LINEBUFFER_HPP
@@ -0,0 +1,453 @@
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "NetworkingError.hpp"
+#include "Reactor.hpp"
+#include "TimeoutError.hpp"
+
+/** Try a call, and throw NetworkingError if it fails. */
+#define CHECK(x) do { if ((x) < 0) { throw NetworkingError("failed to execute " #x); } } while (false)
+
+/** The maximum length of reading from stderr, in bytes. */
+static constexpr size_t MAX_STDERR_LENGTH = 1024 * 1024;
+
+/** The maximum number of events handled per wait. */
+static constexpr auto MAX_EVENTS = 64;
+
+/** The number of low bits of the epoll data holding the event source. */
+static constexpr auto SOURCE_BITS = 2;
+
+/** The epoll data of the wakeup eventfd. */
+static constexpr std::uint64_t WAKEUP = 0;
+
+namespace net {
+
+/** Start the event loop. */
+Reactor::Reactor() {
+    CHECK(epoll = epoll_create1(EPOLL_CLOEXEC));
+    CHECK(wakeup = eventfd(0, EFD_CLOEXEC));
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP;
+    CHECK(epoll_ctl(epoll, EPOLL_CTL_ADD, wakeup, &event));
+    thread = std::thread(&Reactor::run, this);
+}
+
+/**
+ * Get the reactor of the process, starting it on first use.
+ * @return The reactor.
+ */
+Reactor &Reactor::get() {
+    static Reactor reactor;
+    return reactor;
+}
+
+/** Run the event loop until woken up. */
+void Reactor::run() {
+    std::array<epoll_event, MAX_EVENTS> events{};
+    while (true) {
+        const auto count = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Without a working epoll instance, no read can complete
+            return;
+        }
+        std::lock_guard<std::mutex> guard(mutex);
+        for (auto index = 0; index < count; index++) {
+            const auto data = events[index].data.u64;
+            if (data == WAKEUP) {
+                return;
+            }
+            handle(data >> SOURCE_BITS, static_cast<Source>(data & ((1u << SOURCE_BITS) - 1)));
+        }
+    }
+}
+
+/**
+ * Watch a pipe of a channel.
+ * @param operation The epoll_ctl(2) operation.
+ * @param pipe The pipe.
+ * @param channel The channel.
+ * @param source The kind of events of the pipe.
+ * @param events The events to watch for.
+ */
+void Reactor::watch(int operation, Pipe pipe, Channel channel, Source source, std::uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = (channel << SOURCE_BITS) | static_cast<std::uint64_t>(source);
+    CHECK(epoll_ctl(epoll, operation, pipe, &event));
+}
+
+/**
+ * Arm the deadline of a bot for the next step of its exchange, if it has a timeout.
+ * @param entry The entry of the bot.
+ */
+void Reactor::arm(Entry &entry) {
+    if (!entry.timeout) {
+        return;
+    }
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(*entry.timeout);
+    itimerspec deadline{};
+    deadline.it_value.tv_sec = seconds.count();
+    deadline.it_value.tv_nsec = std::chrono::nanoseconds(*entry.timeout - seconds).count();
+    CHECK(timerfd_settime(entry.timer, 0, &deadline, nullptr));
+}
+
+/**
+ * Write as much of the message being sent as the bot's stdin takes.
+ * @param entry The entry of the bot.
+ * @return True if the message was sent in full.
+ */
+bool Reactor::flush(Entry &entry) {
+    using namespace std::chrono;
+    while (entry.next_write < entry.writes.size()) {
+        auto *next = &entry.writes[entry.next_write];
+        const auto count = std::min<size_t>(entry.writes.size() - entry.next_write, IOV_MAX);
+        const auto chars_written = writev(entry.write_pipe, next, static_cast<int>(count));
+        if (chars_written < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                throw NetworkingError("could not send string");
+            }
+            // The bot has not read its input yet; the rest is written once it does
+            if (!entry.blocked) {
+                entry.blocked = true;
+                entry.blocked_since = high_resolution_clock::now();
+                entry.statistics.blocked_writes++;
+            }
+            return false;
+        }
+        entry.statistics.bytes_sent += static_cast<size_t>(chars_written);
+        // Skip the buffers written in full, and the written part of the next one
+        auto written = static_cast<size_t>(chars_written);
+        while (entry.next_write < entry.writes.size() && written >= entry.writes[entry.next_write].iov_len) {
+            written -= entry.writes[entry.next_write].iov_len;
+            entry.next_write++;
+        }
+        if (written > 0) {
+            next = &entry.writes[entry.next_write];
+            next->iov_base = static_cast<char *>(next->iov_base) + written;
+            next->iov_len -= written;
+        }
+    }
+    if (entry.blocked) {
+        entry.blocked = false;
+        entry.statistics.blocked_time += duration_cast<microseconds>(high_resolution_clock::now() - entry.blocked_since);
+    }
+    return true;
+}
+
+/**
+ * Start reading the reply once the message is sent, or complete the exchange if there is none.
+ * @param entry The entry of the bot.
+ * @param channel The channel of the bot.
+ */
+void Reactor::start_read(Entry &entry, Channel channel) {
+    entry.writing = false;
+    entry.reply.sent = std::chrono::high_resolution_clock::now();
+    if (!entry.framing) {
+        const itimerspec disarmed{};
+        timerfd_settime(entry.timer, 0, &disarmed, nullptr);
+        entry.result.set_value(entry.reply);
+        return;
+    }
+    entry.reading = true;
+    // The reply may already be queued or waiting in the pipe
+    if (drain_output(entry)) {
+        return;
+    }
+    if (entry.timeout && *entry.timeout <= std::chrono::milliseconds::zero()) {
+        throw TimeoutError("when reading string", *entry.timeout, entry.lines.partial());
+    }
+    // The reply has its own deadline, counted from the message being sent
+    arm(entry);
+    watch(EPOLL_CTL_MOD, entry.read_pipe, channel, Source::Read, EPOLLIN | EPOLLONESHOT);
+}
+
+/**
+ * Complete the exchange with a reply, if one is queued, disarming the deadline.
+ * @param entry The entry of the bot.
+ * @return True if the exchange completed.
+ */
+bool Reactor::complete(Entry &entry) {
+    if (!entry.lines.pop(entry.reply.message, *entry.framing)) {
+        return false;
+    }
+    entry.reply.received = std::chrono::high_resolution_clock::now();
+    const itimerspec disarmed{};
+    timerfd_settime(entry.timer, 0, &disarmed, nullptr);
+    entry.reading = false;
+    entry.result.set_value(entry.reply);
+    return true;
+}
+
+/**
+ * Fail the exchange, disarming the deadline.
+ * @param entry The entry of the bot.
+ * @param error The error.
+ */
+void Reactor::fail(Entry &entry, std::exception_ptr error) {
+    const itimerspec disarmed{};
+    timerfd_settime(entry.timer, 0, &disarmed, nullptr);
+    entry.writing = false;
+    entry.reading = false;
+    entry.result.set_exception(std::move(error));
+}
+
+/**
+ * Read the available output of a bot, completing the exchange if the reply arrives.
+ * @param entry The entry of the bot.
+ * @return True if the exchange completed.
+ */
+bool Reactor::drain_output(Entry &entry) {
+    while (!complete(entry)) {
+        // Read straight into the line buffer, so that a message is only copied if it wraps
+        const auto [space, space_length] = entry.lines.reserve();
+        const auto bytes_read = read(entry.read_pipe, space, space_length);
+        if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        } else if (bytes_read <= 0) {
+            throw NetworkingError("read failed", entry.lines.partial());
+        }
+        entry.lines.commit(static_cast<size_t>(bytes_read));
+    }
+    return true;
+}
+
+/**
+ * Read the available error output of a bot.
+ * @param entry The entry of the bot.
+ */
+void Reactor::drain_errors(Entry &entry) {
+    while (true) {
+        const auto bytes_read = read(entry.error_pipe, buffer.begin(), buffer.size());
+        if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        } else if (bytes_read <= 0) {
+            // The bot closed stderr; stop watching it, as it would stay readable
+            epoll_ctl(epoll, EPOLL_CTL_DEL, entry.error_pipe, nullptr);
+            entry.error_open = false;
+            return;
+        }
+        // Keep draining past the cap, so the bot does not block on a full pipe
+        const auto kept = std::min(static_cast<size_t>(bytes_read), MAX_STDERR_LENGTH - entry.errors.size());
+        entry.errors.append(buffer.begin(), kept);
+    }
+}
+
+/**
+ * Handle an event of the loop.
+ * @param channel The channel of the event.
+ * @param source The kind of the event.
+ */
+void Reactor::handle(Channel channel, Source source) {
+    auto entry_iterator = entries.find(channel);
+    if (entry_iterator == entries.end()) {
+        // Removed after the event was reported
+        return;
+    }
+    auto &entry = entry_iterator->second;
+    switch (source) {
+    case Source::Error:
+        drain_errors(entry);
+        return;
+    case Source::Write:
+        if (!entry.writing) {
+            return;
+        }
+        try {
+            if (flush(entry)) {
+                start_read(entry, channel);
+            } else {
+                watch(EPOLL_CTL_MOD, entry.write_pipe, channel, Source::Write, EPOLLOUT | EPOLLONESHOT);
+            }
+        } catch (...) {
+            fail(entry, std::current_exception());
+        }
+        return;
+    case Source::Read:
+        if (!entry.reading) {
+            return;
+        }
+        try {
+            if (!drain_output(entry)) {
+                watch(EPOLL_CTL_MOD, entry.read_pipe, channel, Source::Read, EPOLLIN | EPOLLONESHOT);
+            }
+        } catch (...) {
+            fail(entry, std::current_exception());
+        }
+        return;
+    case Source::Timer: {
+        std::uint64_t expirations = 0;
+        if (read(entry.timer, &expirations, sizeof(expirations)) <= 0) {
+            // The timer was disarmed or rearmed since it fired
+            return;
+        }
+        if (entry.writing) {
+            fail(entry, std::make_exception_ptr(TimeoutError("when sending string", *entry.timeout)));
+            return;
+        }
+        if (!entry.reading) {
+            return;
+        }
+        try {
+            // Output that arrived by the deadline still counts
+            if (!drain_output(entry)) {
+                throw TimeoutError("when reading string", *entry.timeout, entry.lines.partial());
+            }
+        } catch (...) {
+            fail(entry, std::current_exception());
+        }
+        return;
+    }
+    }
+}
+
+/**
+ * Register the pipes of a bot. The pipes must be non-blocking, and stay open until removed.
+ * @param read_pipe The stdout pipe of the bot.
+ * @param write_pipe The stdin pipe of the bot.
+ * @param error_pipe The stderr pipe of the bot.
+ * @return The channel of the bot.
+ */
+Reactor::Channel Reactor::add(Pipe read_pipe, Pipe write_pipe, Pipe error_pipe) {
+    std::lock_guard<std::mutex> guard(mutex);
+    const auto channel = next_channel++;
+    auto &entry = entries[channel];
+    entry.read_pipe = read_pipe;
+    entry.write_pipe = write_pipe;
+    entry.error_pipe = error_pipe;
+    try {
+        CHECK(entry.timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+        // Output is only read while a reply is awaited, and input only written while a
+        // message waits for the bot to read, which arm the pipes
+        watch(EPOLL_CTL_ADD, read_pipe, channel, Source::Read, EPOLLONESHOT);
+        watch(EPOLL_CTL_ADD, write_pipe, channel, Source::Write, EPOLLONESHOT);
+        watch(EPOLL_CTL_ADD, error_pipe, channel, Source::Error, EPOLLIN);
+        watch(EPOLL_CTL_ADD, entry.timer, channel, Source::Timer, EPOLLIN);
+    } catch (...) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, read_pipe, nullptr);
+        epoll_ctl(epoll, EPOLL_CTL_DEL, write_pipe, nullptr);
+        epoll_ctl(epoll, EPOLL_CTL_DEL, error_pipe, nullptr);
+        if (entry.timer >= 0) {
+            close(entry.timer);
+        }
+        entries.erase(channel);
+        throw;
+    }
+    return channel;
+}
+
+/**
+ * Unregister the pipes of a bot. No exchange may be pending.
+ * @param channel The channel of the bot.
+ */
+void Reactor::remove(Channel channel) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto entry_iterator = entries.find(channel);
+    if (entry_iterator == entries.end()) {
+        return;
+    }
+    auto &entry = entry_iterator->second;
+    epoll_ctl(epoll, EPOLL_CTL_DEL, entry.read_pipe, nullptr);
+    epoll_ctl(epoll, EPOLL_CTL_DEL, entry.write_pipe, nullptr);
+    if (entry.error_open) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, entry.error_pipe, nullptr);
+    }
+    epoll_ctl(epoll, EPOLL_CTL_DEL, entry.timer, nullptr);
+    close(entry.timer);
+    entries.erase(entry_iterator);
+}
+
+/**
+ * Start an exchange with a bot: send a message, then read the reply if one is expected.
+ * @param channel The channel of the bot.
+ * @param buffers The message, in buffers sent in order, which must stay valid until the exchange completes.
+ * @param framing The framing of the reply, or none to only send.
+ * @param timeout The timeout of sending, and again of the reply, or none to wait indefinitely.
+ * @return The reply. Holds TimeoutError once a timeout passes, or NetworkingError if a pipe fails.
+ */
+std::future<Reply> Reactor::start(Channel channel, const std::vector<std::string_view> &buffers,
+                                  std::optional<Framing> framing, std::optional<std::chrono::milliseconds> timeout) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto &entry = entries.at(channel);
+    entry.result = std::promise<Reply>();
+    auto reply = entry.result.get_future();
+    entry.reply = Reply{};
+    entry.framing = framing;
+    entry.timeout = timeout;
+    entry.writes.clear();
+    for (const auto &buffer : buffers) {
+        if (!buffer.empty()) {
+            entry.writes.push_back({const_cast<char *>(buffer.data()), buffer.size()});
+        }
+    }
+    entry.next_write = 0;
+    try {
+        // Most messages fit in the pipe, and are sent at once
+        if (flush(entry)) {
+            start_read(entry, channel);
+            return reply;
+        }
+        if (timeout && *timeout <= std::chrono::milliseconds::zero()) {
+            throw TimeoutError("when sending string", *timeout);
+        }
+        entry.writing = true;
+        arm(entry);
+        watch(EPOLL_CTL_MOD, entry.write_pipe, channel, Source::Write, EPOLLOUT | EPOLLONESHOT);
+    } catch (...) {
+        fail(entry, std::current_exception());
+    }
+    return reply;
+}
+
+/**
+ * Take the error output of a bot received since the last call.
+ * @param channel The channel of the bot.
+ * @return The error output.
+ */
+std::string Reactor::get_errors(Channel channel) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto &entry = entries.at(channel);
+    // Pick up output written just before the bot failed, which the loop may not have seen yet
+    if (entry.error_open) {
+        drain_errors(entry);
+    }
+    auto errors = std::move(entry.errors);
+    entry.errors.clear();
+    return errors;
+}
+
+/**
+ * Get the statistics of the writes to a bot so far.
+ * @param channel The channel of the bot.
+ * @return The statistics.
+ */
+WriteStatistics Reactor::write_statistics(Channel channel) {
+    std::lock_guard<std::mutex> guard(mutex);
+    return entries.at(channel).statistics;
+}
+
+/** Stop the event loop. */
+Reactor::~Reactor() {
+    const std::uint64_t stop = 1;
+    if (write(wakeup, &stop, sizeof(stop)) == sizeof(stop)) {
+        thread.join();
+    } else {
+        thread.detach();
+    }
+    close(wakeup);
+    close(epoll);
+}
+
+}
+
+#endif // __linux__
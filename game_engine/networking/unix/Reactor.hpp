@@ -0,0 +1,256 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#ifdef __linux__
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/uio.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "LineBuffer.hpp"
+#include "Message.hpp"
+
+namespace net {
+
+/**
+ * Event loop exchanging messages with every bot in the process.
+ *
+ * A single thread waits in epoll(7) on the stdin, stdout and stderr pipes of all
+ * registered bots, together with one timerfd per bot for its deadline. A message is
+ * written as far as the bot's stdin takes it, and the rest is written as the bot reads.
+ * Once it is sent, the bot's reply is read, and a future completes when it arrives, the
+ * deadline passes, or a pipe fails. No thread waits on a bot, so any number of bots may
+ * be served. Stderr is drained as it is written, so that a chatty bot never blocks on it.
+ */
+class Reactor final {
+public:
+    using Pipe = int;              /**< The type of pipes. */
+    using Channel = std::uint64_t; /**< Identifies the pipes of a bot within the reactor. */
+
+private:
+    /** The pipes and exchange state of a bot. */
+    struct Entry {
+        Pipe read_pipe{};                      /**< The stdout pipe of the bot. */
+        Pipe write_pipe{};                     /**< The stdin pipe of the bot. */
+        Pipe error_pipe{};                     /**< The stderr pipe of the bot. */
+        Pipe timer = -1;                       /**< The timerfd for the deadline. */
+        LineBuffer lines;                      /**< The messages read from stdout. */
+        std::string errors;                    /**< The output read from stderr. */
+        bool error_open = true;                /**< Whether stderr is still watched. */
+        std::vector<iovec> writes;             /**< The parts of the message being sent. */
+        size_t next_write{};                   /**< The first part of the message not sent in full. */
+        bool writing = false;                  /**< Whether a message is being sent. */
+        bool reading = false;                  /**< Whether a reply is being read. */
+        std::optional<Framing> framing;        /**< The framing of the reply, or none if only sending. */
+        /** The timeout of sending, and again of reading the reply, or none to wait indefinitely. */
+        std::optional<std::chrono::milliseconds> timeout;
+        Reply reply;                           /**< The reply being received. */
+        std::promise<Reply> result;            /**< The result of the exchange. */
+        WriteStatistics statistics;            /**< The statistics of the writes to the bot. */
+        bool blocked = false;                  /**< Whether the message waits for the bot to read. */
+        /** When the message started waiting for the bot to read. */
+        std::chrono::high_resolution_clock::time_point blocked_since{};
+    };
+
+    /** The kinds of events, stored in the low bits of the epoll data. */
+    enum class Source : std::uint64_t {
+        Read,
+        Write,
+        Error,
+        Timer,
+    };
+
+    /** The buffer size for reading from bots. */
+    static constexpr auto READ_BUFFER_SIZE = 4096;
+
+    Pipe epoll{};                                 /**< The epoll instance. */
+    Pipe wakeup{};                                /**< The eventfd stopping the loop. */
+    std::mutex mutex;                             /**< Guards the entries and all reads and writes. */
+    std::unordered_map<Channel, Entry> entries;   /**< The entries of the registered bots. */
+    Channel next_channel = 1;                     /**< The channel given to the next bot; zero is the wakeup. */
+    std::array<char, READ_BUFFER_SIZE> buffer{};  /**< The bot error read buffer. */
+    std::thread thread;                           /**< The event loop thread. */
+
+    /** Start the event loop. */
+    Reactor();
+
+    /** Run the event loop until woken up. */
+    void run();
+
+    /**
+     * Watch a pipe of a channel.
+     * @param operation The epoll_ctl(2) operation.
+     * @param pipe The pipe.
+     * @param channel The channel.
+     * @param source The kind of events of the pipe.
+     * @param events The events to watch for.
+     */
+    void watch(int operation, Pipe pipe, Channel channel, Source source, std::uint32_t events);
+
+    /**
+     * Arm the deadline of a bot for the next step of its exchange, if it has a timeout.
+     * @param entry The entry of the bot.
+     */
+    void arm(Entry &entry);
+
+    /**
+     * Write as much of the message being sent as the bot's stdin takes.
+     * @param entry The entry of the bot.
+     * @return True if the message was sent in full.
+     */
+    bool flush(Entry &entry);
+
+    /**
+     * Start reading the reply once the message is sent, or complete the exchange if there is none.
+     * @param entry The entry of the bot.
+     * @param channel The channel of the bot.
+     */
+    void start_read(Entry &entry, Channel channel);
+
+    /**
+     * Read the available output of a bot, completing the exchange if the reply arrives.
+     * @param entry The entry of the bot.
+     * @return True if the exchange completed.
+     */
+    bool drain_output(Entry &entry);
+
+    /**
+     * Read the available error output of a bot.
+     * @param entry The entry of the bot.
+     */
+    void drain_errors(Entry &entry);
+
+    /**
+     * Complete the exchange with a reply, if one is queued, disarming the deadline.
+     * @param entry The entry of the bot.
+     * @return True if the exchange completed.
+     */
+    bool complete(Entry &entry);
+
+    /**
+     * Fail the exchange, disarming the deadline.
+     * @param entry The entry of the bot.
+     * @param error The error.
+     */
+    void fail(Entry &entry, std::exception_ptr error);
+
+    /**
+     * Handle an event of the loop.
+     * @param channel The channel of the event.
+     * @param source The kind of the event.
+     */
+    void handle(Channel channel, Source source);
+
+    /**
+     * Start an exchange with a bot: send a message, then read the reply if one is expected.
+     * @param channel The channel of the bot.
+     * @param buffers The message, in buffers sent in order, which must stay valid until the exchange completes.
+     * @param framing The framing of the reply, or none to only send.
+     * @param timeout The timeout of sending, and again of the reply, or none to wait indefinitely.
+     * @return The reply. Holds TimeoutError once a timeout passes, or NetworkingError if a pipe fails.
+     */
+    std::future<Reply> start(Channel channel, const std::vector<std::string_view> &buffers,
+                             std::optional<Framing> framing, std::optional<std::chrono::milliseconds> timeout);
+
+public:
+    /**
+     * Get the reactor of the process, starting it on first use.
+     * @return The reactor.
+     */
+    static Reactor &get();
+
+    /**
+     * Register the pipes of a bot. The pipes must be non-blocking, and stay open until removed.
+     * @param read_pipe The stdout pipe of the bot.
+     * @param write_pipe The stdin pipe of the bot.
+     * @param error_pipe The stderr pipe of the bot.
+     * @return The channel of the bot.
+     */
+    Channel add(Pipe read_pipe, Pipe write_pipe, Pipe error_pipe);
+
+    /**
+     * Unregister the pipes of a bot. No exchange may be pending.
+     * @param channel The channel of the bot.
+     */
+    void remove(Channel channel);
+
+    /**
+     * Send a message to a bot, then read its reply.
+     * @param channel The channel of the bot.
+     * @param buffers The message, in buffers sent in order, which must stay valid until the exchange completes.
+     * @param framing The framing of the reply.
+     * @param timeout The timeout of sending, and again of the reply, or none to wait indefinitely.
+     * @return The reply. Holds TimeoutError once a timeout passes, or NetworkingError if a pipe fails.
+     */
+    std::future<Reply> exchange(Channel channel, const std::vector<std::string_view> &buffers, Framing framing,
+                                std::optional<std::chrono::milliseconds> timeout) {
+        return start(channel, buffers, framing, timeout);
+    }
+
+    /**
+     * Send a message to a bot.
+     * @param channel The channel of the bot.
+     * @param buffers The message, in buffers sent in order, which must stay valid until it is sent.
+     * @param timeout The timeout, or none to wait indefinitely.
+     * @return The time the message was sent, with no reply. Holds TimeoutError once the timeout
+     * passes, or NetworkingError if the pipe fails.
+     */
+    std::future<Reply> send(Channel channel, const std::vector<std::string_view> &buffers,
+                            std::optional<std::chrono::milliseconds> timeout) {
+        return start(channel, buffers, std::nullopt, timeout);
+    }
+
+    /**
+     * Read a line from a bot.
+     * @param channel The channel of the bot.
+     * @param timeout The timeout, or none to wait indefinitely.
+     * @return The line, without its newline. Holds TimeoutError once the timeout passes, or
+     * NetworkingError if the pipe fails.
+     */
+    std::future<Reply> read_line(Channel channel, std::optional<std::chrono::milliseconds> timeout) {
+        return start(channel, {}, Framing::Line, timeout);
+    }
+
+    /**
+     * Read a length-prefixed record from a bot.
+     * @param channel The channel of the bot.
+     * @param timeout The timeout, or none to wait indefinitely.
+     * @return The record, without its length. Holds TimeoutError once the timeout passes, or
+     * NetworkingError if the pipe fails.
+     */
+    std::future<Reply> read_record(Channel channel, std::optional<std::chrono::milliseconds> timeout) {
+        return start(channel, {}, Framing::Record, timeout);
+    }
+
+    /**
+     * Take the error output of a bot received since the last call.
+     * @param channel The channel of the bot.
+     * @return The error output.
+     */
+    std::string get_errors(Channel channel);
+
+    /**
+     * Get the statistics of the writes to a bot so far.
+     * @param channel The channel of the bot.
+     * @return The statistics.
+     */
+    WriteStatistics write_statistics(Channel channel);
+
+    /** Stop the event loop. */
+    ~Reactor();
+};
+
+}
+
+#endif // __linux__
+
+#endif // REACTOR_HPP
@@ -1,8 +1,11 @@
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <csignal>
 #include <fcntl.h>
-#include <sstream>
+#include <mutex>
+#include <poll.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "Logging.hpp"
@@ -20,14 +23,33 @@ static constexpr auto PIPE_HEAD = 0;
 /** The index of the tail of the pipe. */
 static constexpr auto PIPE_TAIL = 1;
 
-/** Offset added to file descriptor, required by select(2). */
-static constexpr auto NFDS_OFFSET = 1;
+/** Timeout value making poll(2) wait indefinitely. */
+static constexpr auto NO_TIMEOUT = -1;
 
+#ifndef __linux__
 /** The maximum length of reading from stderr, in bytes. */
 static constexpr auto MAX_STDERR_LENGTH = 1024 * 1024;
+#endif
 
 namespace net {
 
+/**
+ * Serializes bot launches. Concurrent games launch bots from several threads, and a
+ * child forked while another connection's pipes are open would keep them open,
+ * hiding the exit of that connection's bot; pipes are made close-on-exec under this lock.
+ */
+static std::mutex launch_mutex;
+
+/**
+ * Create a pipe that is not inherited by launched bots.
+ * @param pipe_pair The pipe pair to create.
+ */
+static void make_pipe(int pipe_pair[PIPE_PAIR]) {
+    CHECK(pipe(pipe_pair));
+    CHECK(fcntl(pipe_pair[PIPE_HEAD], F_SETFD, FD_CLOEXEC));
+    CHECK(fcntl(pipe_pair[PIPE_TAIL], F_SETFD, FD_CLOEXEC));
+}
+
 /**
  * Initialize a UnixConnection to a new process using a command.
  * Spawns the process, and binds two pipes to it for I/O.
@@ -42,9 +64,10 @@ UnixConnection::UnixConnection(const std::string &command, NetworkingConfig conf
     int error_pipe[PIPE_PAIR];
     // Ignore SIGPIPE, as we want to detect bot exit gracefully.
     signal(SIGPIPE, SIG_IGN);
-    CHECK(pipe(write_pipe));
-    CHECK(pipe(read_pipe));
-    CHECK(pipe(error_pipe));
+    std::lock_guard<std::mutex> guard(launch_mutex);
+    make_pipe(write_pipe);
+    make_pipe(read_pipe);
+    make_pipe(error_pipe);
     // Make the write pipe non-blocking
     CHECK(fcntl(write_pipe[PIPE_TAIL], F_SETFL, O_NONBLOCK));
     // Make the error pipe non-blocking
@@ -81,6 +104,11 @@ UnixConnection::UnixConnection(const std::string &command, NetworkingConfig conf
     this->error_pipe = error_pipe[PIPE_HEAD];
     close(error_pipe[PIPE_TAIL]);
     process = pid;
+#ifdef __linux__
+    // The reactor reads stdout without blocking its loop
+    CHECK(fcntl(this->read_pipe, F_SETFL, O_NONBLOCK));
+    channel = Reactor::get().add(this->read_pipe, this->write_pipe, this->error_pipe);
+#endif
 }
 
 /**
@@ -88,6 +116,12 @@ UnixConnection::UnixConnection(const std::string &command, NetworkingConfig conf
  */
 UnixConnection::~UnixConnection() noexcept {
     kill(-process, SIGKILL);
+#ifdef __linux__
+    Reactor::get().remove(channel);
+#endif
+    close(read_pipe);
+    close(write_pipe);
+    close(error_pipe);
 }
 
 /**
@@ -96,149 +130,175 @@ UnixConnection::~UnixConnection() noexcept {
  * @throws NetworkingError if message could not be sent.
  */
 void UnixConnection::send_string(const std::string &message) {
-    auto length = message.length();
-    Logging::log([length]() { return "Sending message with length " + std::to_string(length); }, Logging::Level::Debug);
-    auto message_ptr = message.c_str();
-    auto chars_remaining = static_cast<size_t>(length);
+    send_buffers({message});
+}
+
+/**
+ * Send several buffers along this connection, as one message.
+ * Whenever the bot's input is full, the rest is written as the bot reads, until the timeout passes.
+ * @param buffers The buffers to send, in order.
+ * @throws NetworkingError if the message could not be sent.
+ */
+void UnixConnection::send_buffers(const std::vector<std::string_view> &buffers) {
+    Logging::log([&buffers]() {
+        size_t length = 0;
+        for (const auto &buffer : buffers) {
+            length += buffer.size();
+        }
+        return "Sending message with length " + std::to_string(length);
+    }, Logging::Level::Debug);
+#ifdef __linux__
+    // The reactor writes what the bot does not take at once, without a thread waiting on it
+    Reactor::get().send(channel, buffers, deadline(config.timeout)).get();
+#else
+    std::vector<iovec> pending;
+    pending.reserve(buffers.size());
+    for (const auto &buffer : buffers) {
+        if (!buffer.empty()) {
+            pending.push_back({const_cast<char *>(buffer.data()), buffer.size()});
+        }
+    }
 
     using namespace std::chrono;
     auto initial_time = high_resolution_clock::now();
-    while (chars_remaining > 0) {
-        if (!config.ignore_timeout) {
-            auto current_time = high_resolution_clock::now();
-            auto remaining = config.timeout - duration_cast<milliseconds>(current_time - initial_time);
-            if (remaining < milliseconds::zero()) {
-                throw TimeoutError("when sending string", config.timeout);
-            }
-        }
-        ssize_t chars_written = write(write_pipe, message_ptr, chars_remaining);
+    auto next = pending.begin();
+    while (next != pending.end()) {
+        const auto count = std::min<std::ptrdiff_t>(pending.end() - next, IOV_MAX);
+        ssize_t chars_written = writev(write_pipe, &*next, static_cast<int>(count));
         if (chars_written < 0) {
-            switch (errno) {
-            case EAGAIN:
-                continue;
-            default:
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
                 throw NetworkingError("could not send string");
             }
+            // The bot has not read its input yet; wait until it does
+            auto wait = NO_TIMEOUT;
+            if (!config.ignore_timeout) {
+                auto remaining = config.timeout - duration_cast<milliseconds>(high_resolution_clock::now() - initial_time);
+                if (remaining < milliseconds::zero()) {
+                    throw TimeoutError("when sending string", config.timeout);
+                }
+                wait = static_cast<int>(remaining.count());
+            }
+            pollfd poll_pipe{write_pipe, POLLOUT, 0};
+            const auto blocked_start = high_resolution_clock::now();
+            const auto poll_result = poll(&poll_pipe, 1, wait);
+            statistics.blocked_writes++;
+            statistics.blocked_time += duration_cast<microseconds>(high_resolution_clock::now() - blocked_start);
+            if (poll_result < 0 && errno != EINTR) {
+                throw NetworkingError("poll failed");
+            } else if (poll_result == 0) {
+                throw TimeoutError("when sending string", config.timeout);
+            }
+            continue;
+        }
+        statistics.bytes_sent += static_cast<size_t>(chars_written);
+        // Skip the buffers written in full, and the written part of the next one
+        auto written = static_cast<size_t>(chars_written);
+        while (next != pending.end() && written >= next->iov_len) {
+            written -= next->iov_len;
+            ++next;
+        }
+        if (written > 0) {
+            next->iov_base = static_cast<char *>(next->iov_base) + written;
+            next->iov_len -= written;
         }
-        message_ptr += chars_written;
-        chars_remaining -= chars_written;
     }
+#endif
 }
 
 /**
- * Check a pipe to see if it has available bytes, blocking indefinitely.
- * @param pipe The pipe to check.
- * @return Result of select(2) on the pipe.
+ * Get the statistics of the writes to the bot so far.
+ * @return The statistics.
  */
-int check_pipe(int pipe) {
-    fd_set set;
-    FD_ZERO(&set);
-    assert(pipe <= FD_SETSIZE);
-    FD_SET(pipe, &set);
-    return select(pipe + NFDS_OFFSET, &set, nullptr, nullptr, nullptr);
+WriteStatistics UnixConnection::write_statistics() const {
+#ifdef __linux__
+    return Reactor::get().write_statistics(channel);
+#else
+    return statistics;
+#endif
 }
 
 /**
- * Check a pipe to see if it has available bytes, blocking until timeout.
- * @param pipe The pipe to check.
- * @param timeout The timeout.
- * @return Result of select(2) on the pipe.
+ * Get a string from this connection.
+ * @param timeout The timeout to use.
+ * @return The string read, valid until the next read from this connection.
+ * @throws NetworkingError on error while reading.
  */
-int check_pipe(int pipe, std::chrono::milliseconds timeout) {
-    fd_set set;
-    FD_ZERO(&set);
-    assert(pipe <= FD_SETSIZE);
-    FD_SET(pipe, &set);
-    struct timeval timeout_struct{};
-    auto sec = std::chrono::duration_cast<std::chrono::seconds>(timeout);
-    timeout_struct.tv_sec = sec.count();
-    timeout_struct.tv_usec = (timeout - sec).count();
-    return select(pipe + NFDS_OFFSET, &set, nullptr, nullptr, &timeout_struct);
+std::string_view UnixConnection::get_string(std::chrono::milliseconds timeout) {
+#ifdef __linux__
+    return Reactor::get().read_line(channel, deadline(timeout)).get().message;
+#else
+    return get_message(timeout, Framing::Line);
+#endif
 }
 
 /**
- * Get a string from this connection.
+ * Get a record, prefixed by its length as a 32-bit little-endian integer, from this connection.
+ * @param timeout The timeout to use.
+ * @return The record, without its length, valid until the next read from this connection.
+ * @throws NetworkingError on error while reading.
+ */
+std::string_view UnixConnection::get_record(std::chrono::milliseconds timeout) {
+#ifdef __linux__
+    return Reactor::get().read_record(channel, deadline(timeout)).get().message;
+#else
+    return get_message(timeout, Framing::Record);
+#endif
+}
+
+#ifndef __linux__
+/**
+ * Get a message from this connection.
  * @param timeout The timeout to use.
- * @return The string read.
+ * @param framing The framing of the message.
+ * @return The message, valid until the next read from this connection.
  * @throws NetworkingError on error while reading.
  */
-std::string UnixConnection::get_string(std::chrono::milliseconds timeout) {
-    // Try the queue first
-    if (!message_queue.empty()) {
-        // COPY not reference since pop_front invalidates references
-        const std::string message = message_queue.front();
-        message_queue.pop_front();
+std::string_view UnixConnection::get_message(std::chrono::milliseconds timeout, Framing framing) {
+    // Try the messages already read first
+    std::string_view message;
+    if (lines.pop(message, framing)) {
         return message;
     }
 
     using namespace std::chrono;
     auto initial_time = high_resolution_clock::now();
     while (true) {
-        // Check if there are bytes in the pipe
-        int selection_result = 0;
-        if (config.ignore_timeout) {
-            selection_result = check_pipe(read_pipe);
-        } else {
-            selection_result = check_pipe(read_pipe, milliseconds::zero());
-            if (selection_result < 0) {
-                throw NetworkingError("select failed", current_read);
-            } else if (selection_result == 0) {
-                auto current_time = high_resolution_clock::now();
-                auto remaining = timeout - duration_cast<milliseconds>(current_time - initial_time);
-                if (remaining < milliseconds::zero()) {
-                    throw TimeoutError("when reading string", timeout, current_read);
-                }
-                selection_result = check_pipe(read_pipe, remaining);
-            }
+        // Wait for bytes in the pipe; unlike select(2), poll(2) takes descriptors of any value
+        auto wait = NO_TIMEOUT;
+        if (!config.ignore_timeout) {
+            auto current_time = high_resolution_clock::now();
+            auto remaining = timeout - duration_cast<milliseconds>(current_time - initial_time);
+            wait = static_cast<int>(std::max(remaining, milliseconds::zero()).count());
         }
-        if (selection_result < 0) {
-            throw NetworkingError("select failed", current_read);
-        } else if (selection_result > 0) {
-            // Read from the pipe, as many as we can into the buffer
-            auto bytes_read = read(read_pipe, buffer.begin(), buffer.size());
-            if (bytes_read <= 0) {
-                throw NetworkingError("read failed", current_read);
-            }
-            // Iterator one past the last read character
-            auto read_end = buffer.begin() + bytes_read;
-            // Identify whether a newline exists in the buffer
-            auto newline_pos = std::find(buffer.begin(), read_end, '\n');
-            if (newline_pos == read_end) {
-                // No newline was found, append the entire read to the result
-                current_read += std::string(buffer.begin(), read_end);
-                // Keep reading until we find a newline eventually
-                continue;
-            } else {
-                // Newline was found; append the read to the result, up to but not including the newline
-                current_read += std::string(buffer.begin(), newline_pos);
-                auto result = current_read;
-
-                // There may be more newlines; tokenize the remainder
-                auto string_end = ++newline_pos;
-                auto read = std::string(string_end, read_end);
-                std::stringstream stream(read);
-                auto more_messages = false;
-                while (std::getline(stream, current_read)) {
-                    more_messages = true;
-                    message_queue.push_back(current_read);
-                }
-                if (more_messages && read.back() != '\n') {
-                    // The last element is not yet done, don't queue it
-                    message_queue.pop_back();
-                } else {
-                    current_read = "";
-                }
-                return result;
-            }
+        pollfd poll_pipe{read_pipe, POLLIN, 0};
+        auto poll_result = poll(&poll_pipe, 1, wait);
+        if (poll_result < 0) {
+            throw NetworkingError("poll failed", lines.partial());
+        } else if (poll_result == 0) {
+            throw TimeoutError("when reading string", timeout, lines.partial());
+        }
+        // Read from the pipe, as many as we can, straight into the line buffer
+        const auto [space, space_length] = lines.reserve();
+        auto bytes_read = read(read_pipe, space, space_length);
+        if (bytes_read <= 0) {
+            throw NetworkingError("read failed", lines.partial());
+        }
+        lines.commit(static_cast<size_t>(bytes_read));
+        if (lines.pop(message, framing)) {
+            return message;
         }
     }
 }
+#endif
 
 /**
  * Get the error output from this connection.
  * @return The error output.
  */
 std::string UnixConnection::get_errors() {
+#ifdef __linux__
+    return Reactor::get().get_errors(channel);
+#else
     std::string result;
     ssize_t bytes_read = 0;
     while ((bytes_read = read(error_pipe, buffer.begin(), buffer.size())) > 0
@@ -246,6 +306,7 @@ std::string UnixConnection::get_errors() {
         result += std::string(buffer.begin(), buffer.begin() + bytes_read);
     }
     return result;
+#endif
 }
 
 }
@@ -2,19 +2,23 @@
 #define UNIXCONNECTION_HPP
 
 #include <array>
-#include <deque>
 
 #include "Connection.hpp"
+#include "LineBuffer.hpp"
+#include "Reactor.hpp"
 
 namespace net {
 
 /** Connections based on UNIX processes and pipes. */
 class UnixConnection final : public BaseConnection {
 private:
-    static constexpr auto READ_BUFFER_SIZE = 256; /**< The buffer size for reading from bots. */
-    std::array<char, READ_BUFFER_SIZE> buffer{};  /**< The bot read buffer. */
-    std::string current_read;                     /**< Accumulated last read, waiting for a newline. */
-    std::deque<std::string> message_queue;        /**< Queue for messages that have not been retrieved. */
+#ifdef __linux__
+    Reactor::Channel channel{};                   /**< The channel of the bot in the reactor, which does its I/O. */
+#else
+    static constexpr auto READ_BUFFER_SIZE = 256; /**< The buffer size for reading errors from bots. */
+    std::array<char, READ_BUFFER_SIZE> buffer{};  /**< The bot error read buffer. */
+    LineBuffer lines;                             /**< The messages read from the bot. */
+#endif
 
     using Process = pid_t;
     using Pipe = int;
@@ -24,6 +28,28 @@ private:
     Pipe error_pipe{}; /** The error pipe. */
     Process process{}; /** The process. */
 
+#ifdef __linux__
+    /**
+     * Get the deadline of a step of an exchange, as the reactor takes it.
+     * @param timeout The timeout.
+     * @return The timeout, or none if timeouts are ignored.
+     */
+    std::optional<std::chrono::milliseconds> deadline(std::chrono::milliseconds timeout) const {
+        return config.ignore_timeout ? std::nullopt : std::optional<std::chrono::milliseconds>(timeout);
+    }
+#else
+    WriteStatistics statistics; /**< The statistics of the writes to the bot. */
+
+    /**
+     * Get a message from this connection.
+     * @param timeout The timeout to use.
+     * @param framing The framing of the message.
+     * @return The message, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    std::string_view get_message(std::chrono::milliseconds timeout, Framing framing);
+#endif
+
 public:
     /**
      * Initialize a UnixConnection to a new process using a command.
@@ -41,22 +67,69 @@ public:
      */
     void send_string(const std::string &message) override;
 
+    /**
+     * Send several buffers along this connection, as one message, in as few writes as the bot allows.
+     * @param buffers The buffers to send, in order.
+     * @throws NetworkingError if the message could not be sent.
+     */
+    void send_buffers(const std::vector<std::string_view> &buffers) override;
+
+    /**
+     * Get the statistics of the writes to the bot so far.
+     * @return The statistics.
+     */
+    WriteStatistics write_statistics() const override;
+
+#ifdef __linux__
+    /**
+     * Send several buffers along this connection, as one message, then read the reply.
+     * The reactor does both, so that no thread waits on the bot.
+     * @param buffers The buffers to send, in order, which must stay valid until the reply is read.
+     * @param framing The framing of the reply.
+     * @param timeout The timeout of sending, and again of the reply.
+     * @return The reply, valid until the next read from this connection. Holds NetworkingError
+     * if the message could not be sent or the reply could not be read.
+     */
+    std::future<Reply> exchange(const std::vector<std::string_view> &buffers, Framing framing,
+                                std::chrono::milliseconds timeout) override {
+        return Reactor::get().exchange(channel, buffers, framing, deadline(timeout));
+    }
+#endif
+
     /**
      * Get a string from this connection.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    std::string get_string() override {
+    std::string_view get_string() override {
         return get_string(config.timeout);
     }
 
     /**
      * Get a string from this connection.
      * @param timeout The timeout to use.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    std::string_view get_string(std::chrono::milliseconds timeout) override;
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this
+     * connection with configured timeout.
+     * @return The record, without its length, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    std::string_view get_record() override {
+        return get_record(config.timeout);
+    }
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this connection.
+     * @param timeout The timeout to use.
+     * @return The record, without its length, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    std::string get_string(std::chrono::milliseconds timeout) override;
+    std::string_view get_record(std::chrono::milliseconds timeout) override;
 
     /**
      * Get the error output from this connection.
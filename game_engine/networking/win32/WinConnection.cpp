@@ -122,48 +122,79 @@ void WinConnection::send_string(const std::string &message) {
 }
 
 /**
- * Get a string from this connection.
- * @param timeout The timeout to use.
- * @return The string read.
+ * Read a byte from the bot, appending it to the message.
+ * @param initial_time The time at which the read of the message began.
+ * @param timeout The timeout of the read of the message.
+ * @throws NetworkingError on error while reading.
  */
-std::string WinConnection::get_string(std::chrono::milliseconds timeout) {
-    char buffer;
-    std::string result;
-
+void WinConnection::read_byte(std::chrono::high_resolution_clock::time_point initial_time,
+                              std::chrono::milliseconds timeout) {
     using namespace std::chrono;
-    auto initial_time = high_resolution_clock::now();
+    DWORD bytes_available = 0;
     while (true) {
-        DWORD bytes_available = 0;
-        while (true) {
-            if (!config.ignore_timeout) {
-                auto current_time = high_resolution_clock::now();
-                auto remaining = timeout - duration_cast<milliseconds>(current_time - initial_time);
-                if (remaining < milliseconds::zero()) {
-                    throw TimeoutError("when reading string", timeout, result);
-                }
+        if (!config.ignore_timeout) {
+            auto current_time = high_resolution_clock::now();
+            auto remaining = timeout - duration_cast<milliseconds>(current_time - initial_time);
+            if (remaining < milliseconds::zero()) {
+                throw TimeoutError("when reading string", timeout, message);
             }
+        }
 
-            PeekNamedPipe(read_pipe, nullptr, 0, nullptr, &bytes_available, nullptr);
-
-            if (bytes_available > 0) {
-                break;
-            }
+        PeekNamedPipe(read_pipe, nullptr, 0, nullptr, &bytes_available, nullptr);
 
-            Sleep(1);
+        if (bytes_available > 0) {
+            break;
         }
 
-        DWORD chars_read;
-        auto success = ReadFile(read_pipe, &buffer, 1, &chars_read, nullptr);
-        if (!success || chars_read < 1) {
-            throw NetworkingError("Could not read from pipe", result);
-        }
-        if (buffer == '\n') {
-            break;
-        } else {
-            result += buffer;
+        Sleep(1);
+    }
+
+    char buffer;
+    DWORD chars_read;
+    auto success = ReadFile(read_pipe, &buffer, 1, &chars_read, nullptr);
+    if (!success || chars_read < 1) {
+        throw NetworkingError("Could not read from pipe", message);
+    }
+    message += buffer;
+}
+
+/**
+ * Get a string from this connection.
+ * @param timeout The timeout to use.
+ * @return The string read, valid until the next read from this connection.
+ */
+std::string_view WinConnection::get_string(std::chrono::milliseconds timeout) {
+    message.clear();
+    const auto initial_time = std::chrono::high_resolution_clock::now();
+    while (true) {
+        read_byte(initial_time, timeout);
+        if (message.back() == '\n') {
+            message.pop_back();
+            return message;
         }
     }
-    return result;
+}
+
+/**
+ * Get a record, prefixed by its length as a 32-bit little-endian integer, from this connection.
+ * @param timeout The timeout to use.
+ * @return The record, without its length, valid until the next read from this connection.
+ */
+std::string_view WinConnection::get_record(std::chrono::milliseconds timeout) {
+    static constexpr size_t LENGTH_SIZE = 4;
+    message.clear();
+    const auto initial_time = std::chrono::high_resolution_clock::now();
+    while (message.size() < LENGTH_SIZE) {
+        read_byte(initial_time, timeout);
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < LENGTH_SIZE; i++) {
+        length |= static_cast<size_t>(static_cast<unsigned char>(message[i])) << (8 * i);
+    }
+    while (message.size() < LENGTH_SIZE + length) {
+        read_byte(initial_time, timeout);
+    }
+    return std::string_view(message).substr(LENGTH_SIZE);
 }
 
 /**
@@ -19,6 +19,16 @@ class WinConnection final : public BaseConnection {
     Pipe write_pipe{}; /** The write pipe. */
     Process process{}; /** The process. */
 
+    std::string message; /**< The last message read, viewed by get_string and get_record. */
+
+    /**
+     * Read a byte from the bot, appending it to the message.
+     * @param initial_time The time at which the read of the message began.
+     * @param timeout The timeout of the read of the message.
+     * @throws NetworkingError on error while reading.
+     */
+    void read_byte(std::chrono::high_resolution_clock::time_point initial_time, std::chrono::milliseconds timeout);
+
 public:
     /**
      * Initialize a WinConnection to a new process using a command.
@@ -38,20 +48,38 @@ public:
 
     /**
      * Get a string from this connection.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    std::string get_string() override {
+    std::string_view get_string() override {
         return get_string(config.timeout);
     }
 
     /**
      * Get a string from this connection.
      * @param timeout The timeout to use.
-     * @return The string read.
+     * @return The string read, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    std::string_view get_string(std::chrono::milliseconds timeout) override;
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this
+     * connection with configured timeout.
+     * @return The record, without its length, valid until the next read from this connection.
+     * @throws NetworkingError on error while reading.
+     */
+    std::string_view get_record() override {
+        return get_record(config.timeout);
+    }
+
+    /**
+     * Get a record, prefixed by its length as a 32-bit little-endian integer, from this connection.
+     * @param timeout The timeout to use.
+     * @return The record, without its length, valid until the next read from this connection.
      * @throws NetworkingError on error while reading.
      */
-    std::string get_string(std::chrono::milliseconds timeout) override;
+    std::string_view get_record(std::chrono::milliseconds timeout) override;
 
     /**
      * Get the error output from this connection.
@@ -78,25 +78,12 @@ void Turn::add_entities(Store &store) {
     for (const auto &[player_id, _player] : store.players) {
         entities[player_id] = {};
     }
-    for (const auto &[entity_id, entity] : store.entities) {
-        const auto location = store.get_player(entity.owner).get_entity_location(entity.id);
-        const EntityInfo entity_info = {location, entity};
+    for (const auto &entity : store.entities) {
+        const EntityInfo entity_info = {entity.location, entity};
         entities[entity.owner].insert( {{entity.id, entity_info}} );
     }
 }
 
-/**
- * Add cells changed on this turn to the replay file
- * @param map The game map (to access cell energy)
- * @param cells The locations of changed cells
- */
-void Turn::add_cells(Map &map, std::unordered_set<Location> changed_cells){
-    for (const auto location : changed_cells) {
-        const auto cell = map.at(location);
-        this->cells.emplace_back(location, cell);
-    }
-}
-
 /**
  * Given the game store, add all state from end of turn in replay
  * param store The game store at the end of the turn
@@ -129,6 +116,9 @@ void to_json(nlohmann::json &json, const Replay *replay) {
         players_json.push_back(player);
     }
     json["players"] = players_json;
+    if (replay->include_timing) {
+        json["timing"] = timing_series(replay->game_statistics);
+    }
 }
 
 /**
@@ -184,4 +174,31 @@ void Replay::output(std::string filename, bool enable_compression) {
     gameFile.close();
 }
 
+/**
+ * Read a replay file written by output(), compressed or not.
+ *
+ * @param filename The replay file
+ * @return The replay in json format
+ * @throws std::runtime_error if the file cannot be read or decompressed
+ */
+nlohmann::json Replay::read(const std::string &filename) {
+    std::ifstream gameFile(filename, std::ios_base::binary);
+    if (!gameFile.is_open())
+        throw std::runtime_error("Could not open replay file " + filename);
+    std::string data((std::istreambuf_iterator<char>(gameFile)), std::istreambuf_iterator<char>());
+
+    // Compressed replays are a single zstd frame that records its decompressed size
+    const auto data_size = ZSTD_getFrameContentSize(data.data(), data.size());
+    if (data_size == ZSTD_CONTENTSIZE_ERROR) {
+        return nlohmann::json::parse(data);
+    }
+    if (data_size == ZSTD_CONTENTSIZE_UNKNOWN)
+        throw std::runtime_error("Unknown decompressed size of replay file " + filename);
+    std::string decompressed(data_size, '\0');
+    auto result = ZSTD_decompress(decompressed.data(), decompressed.size(), data.data(), data.size());
+    if (ZSTD_isError(result))
+        throw std::runtime_error("Could not decompress replay file " + filename);
+    return nlohmann::json::parse(decompressed);
+}
+
 }
@@ -54,7 +54,7 @@ struct EntityInfo {
 struct Turn {
     using Entities = id_map<Entity, EntityInfo>;
     /** Mapping from player id to the commands they issued this turn */
-    ordered_id_map<Player, std::vector<std::unique_ptr<Command>>> moves;
+    ordered_id_map<Player, std::vector<Command>> moves;
     id_map<Player, energy_type> energy;  /**< Mapping from player id to the energy they ended the turn with */
     id_map<Player, energy_type> deposited; /**< Mapping from player id to the total energy they deposited by the end of turn */
     std::vector<GameEvent> events;       /**< Events occurring this turn (spawns, deaths, etc) for replay */
@@ -76,10 +76,16 @@ struct Turn {
 
     /**
      * Add cells changed on this turn to the replay file
+     * @tparam Cells The type of the container of locations.
      * @param map The game map (to access cell energy)
-     * @param cells The locations of changed cells
+     * @param changed_cells The locations of changed cells
      */
-    void add_cells(Map &map, std::unordered_set<Location> changed_cells);
+    template<class Cells>
+    void add_cells(Map &map, const Cells &changed_cells) {
+        for (const auto &location : changed_cells) {
+            cells.emplace_back(location, map.at(location));
+        }
+    }
 
     /**
      * Given the game store, add all state from end of turn in replay
@@ -112,6 +118,7 @@ struct Replay {
     std::vector<hlt::Turn> full_frames{};                       /**< Turn information: first element = first frame/turn. Length is game_statistics.number_turns */
 
     unsigned int map_generator_seed;                            /**< Seed used in random number generator for map */
+    bool include_timing{};                                      /**< Whether to add the per-turn timing and traffic of the game */
     const Map production_map;                                   /**< Map of cells game was played on, including factory and other cells. Struct incldues name of map generator */
 
     /**
@@ -140,6 +147,15 @@ struct Replay {
      */
     void output(std::string filename, bool enable_compression);
 
+    /**
+     * Read a replay file written by output(), compressed or not.
+     *
+     * @param filename The replay file
+     * @return The replay in json format
+     * @throws std::runtime_error if the file cannot be read or decompressed
+     */
+    static nlohmann::json read(const std::string &filename);
+
     /** Create Replay from Game statistics, number of players, initial list of players, seed for the map generation, and the generated map
      *
      * @param game_statistics Reference access to game_statistics struct that will be updated during game play
@@ -0,0 +1,72 @@
+#include <fstream>
+#include <sstream>
+
+#include "BatchRunner.hpp"
+#include "Logging.hpp"
+#include "Networking.hpp"
+#include "ThreadPool.hpp"
+
+namespace hlt {
+
+/**
+ * Read game specs from a batch description.
+ * @param json The batch description.
+ * @return The game specs.
+ * @throws nlohmann::json::exception if the description is malformed.
+ */
+std::vector<GameSpec> read_batch(const nlohmann::json &json) {
+    const auto base_seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+    std::vector<GameSpec> specs;
+    for (const auto &game : json) {
+        GameSpec spec;
+        const auto index = specs.size();
+        spec.seed = game.value("seed", static_cast<unsigned int>(base_seed + index));
+        spec.width = game.value("width", dimension_type{});
+        spec.height = game.value("height", dimension_type{});
+        spec.num_players = game.value("players", spec.num_players);
+        if (game.count("map_type") > 0) {
+            std::istringstream type_stream(game.at("map_type").get<std::string>());
+            type_stream >> spec.map_type;
+        }
+        spec.bot_commands = game.at("bots").get<std::vector<std::string>>();
+        spec.names = game.value("names", spec.names);
+        spec.turn_limit = game.value("turn_limit", spec.turn_limit);
+        spec.snapshot = game.value("snapshot", spec.snapshot);
+        spec.label = game.value("label", std::to_string(index));
+        specs.emplace_back(std::move(spec));
+    }
+    return specs;
+}
+
+/**
+ * Run games concurrently on a work-stealing thread pool.
+ * @param specs The games to run.
+ * @param config The output and networking options.
+ * @param num_threads The number of games to run at once.
+ * @return The results of the games, in the order of the specs.
+ */
+nlohmann::json run_batch(const std::vector<GameSpec> &specs, const RunnerConfig &config, size_t num_threads) {
+    std::vector<nlohmann::json> results(specs.size());
+    // Bots that accept to play several games are kept for later games, and killed at the end
+    net::ConnectionPool bots;
+    auto batch_config = config;
+    batch_config.pool = &bots;
+    {
+        ThreadPool pool(num_threads);
+        for (size_t index = 0; index < specs.size(); index++) {
+            pool.submit([&spec = specs[index], &result = results[index], &config = batch_config] {
+                try {
+                    result = run_game(spec, config);
+                } catch (const std::exception &e) {
+                    Logging::log(std::string("Game could not be run: ") + e.what(), Logging::Level::Error);
+                    result = {{"label", spec.label}, {"error", e.what()}};
+                }
+                std::ofstream results_file(config.replay_directory + "results-" + spec.label + ".json");
+                results_file << result.dump() << std::endl;
+            });
+        }
+    }
+    return results;
+}
+
+}
@@ -0,0 +1,37 @@
+#ifndef BATCHRUNNER_HPP
+#define BATCHRUNNER_HPP
+
+#include "GameRunner.hpp"
+
+namespace hlt {
+
+/**
+ * Read game specs from a batch description.
+ *
+ * The description is a JSON array with an object per game. The key "bots" lists the bot
+ * commands; the optional keys are "seed", "width", "height", "players", "map_type",
+ * "names", "turn_limit", "snapshot" and "label". Games without a label are labelled by
+ * their index, and games without a seed get consecutive seeds from the current time.
+ *
+ * @param json The batch description.
+ * @return The game specs.
+ * @throws nlohmann::json::exception if the description is malformed.
+ */
+std::vector<GameSpec> read_batch(const nlohmann::json &json);
+
+/**
+ * Run games concurrently on a work-stealing thread pool.
+ * The results of each game are also written to results-<label>.json in the replay directory.
+ * Bots that accept to play several games are reused by later games with the same command.
+ *
+ * @param specs The games to run.
+ * @param config The output and networking options.
+ * @param num_threads The number of games to run at once.
+ * @return The results of the games, in the order of the specs. A game that could not
+ * be run has only its label and an "error" message.
+ */
+nlohmann::json run_batch(const std::vector<GameSpec> &specs, const RunnerConfig &config, size_t num_threads);
+
+}
+
+#endif // BATCHRUNNER_HPP
@@ -0,0 +1,207 @@
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "Constants.hpp"
+#include "GameRunner.hpp"
+#include "Halite.hpp"
+#include "Logging.hpp"
+#include "Replay.hpp"
+#include "Snapshot.hpp"
+
+namespace hlt {
+
+/**
+ * Run a game to completion and write its replay and logs.
+ *
+ * The game runs with a private copy of the current constants, and may run concurrently
+ * with other games on other threads.
+ *
+ * @param spec The game to run.
+ * @param config The output and networking options.
+ * @param start The time the game was requested, for the execution time.
+ * @return The results of the game, in the format used by the backend.
+ * @throws std::invalid_argument if the game has too many players.
+ * @throws SnapshotError if the snapshot is malformed.
+ */
+nlohmann::json run_game(const GameSpec &spec, const RunnerConfig &config,
+                        std::chrono::system_clock::time_point start) {
+    // Games adjust the constants to their map, so each game gets its own.
+    Constants::Scope scope;
+    auto &constants = Constants::get_mut();
+    Logging::set_context({Logging::init_turn, spec.label});
+
+    if (spec.bot_commands.size() > constants.MAX_PLAYERS) {
+        throw std::invalid_argument("Too many players (max is " + std::to_string(constants.MAX_PLAYERS) + ")");
+    }
+
+    if (spec.turn_limit > 0) {
+        constants.MAX_TURNS = spec.turn_limit;
+        constants.MIN_TURNS = spec.turn_limit;
+    }
+
+    // Use the seed to determine default map size
+    std::mt19937 rng(spec.seed);
+    std::vector<dimension_type> map_sizes = {32, 40, 48, 56, 64};
+    auto base_size = map_sizes[rng() % map_sizes.size()];
+    constants.DEFAULT_MAP_WIDTH = constants.DEFAULT_MAP_HEIGHT = base_size;
+
+    // Get the map parameters
+    auto map_width = spec.width > 0 ? spec.width : constants.DEFAULT_MAP_WIDTH;
+    auto map_height = spec.height > 0 ? spec.height : constants.DEFAULT_MAP_HEIGHT;
+    auto n_players = std::max(spec.num_players, static_cast<unsigned long>(spec.bot_commands.size()));
+    mapgen::MapParameters map_parameters{spec.map_type, spec.seed, map_width, map_height, n_players};
+
+    Snapshot snapshot;
+    if (!spec.snapshot.empty()) {
+        snapshot = Snapshot::from_str(spec.snapshot);
+        map_parameters = snapshot.map_param;
+    }
+
+    net::NetworkingConfig networking_config{};
+    networking_config.ignore_timeout = config.ignore_timeout;
+    networking_config.pool = config.pool;
+
+    Map map(map_parameters.width, map_parameters.height);
+    mapgen::Generator::generate(map, map_parameters);
+
+    std::string replay_directory = config.replay_directory;
+
+    GameStatistics game_statistics;
+    Replay replay{game_statistics, map_parameters.num_players, map_parameters.seed, map};
+    replay.include_timing = config.replay_timing;
+    Logging::log("Map seed is " + std::to_string(map_parameters.seed));
+
+    game_statistics.map_total_halite += map.total_energy();
+
+    Halite game(map, networking_config, game_statistics, replay);
+    game.run_game(spec.bot_commands, snapshot);
+
+    auto idx = 0;
+    for (const auto &name : spec.names) {
+        if (idx < static_cast<int>(replay.players.size())) {
+            replay.players.at(Player::id_type{idx}).name = name;
+        }
+        idx++;
+    }
+
+    // JSON results info, used by backend
+    nlohmann::json results;
+    results["error_logs"] = nlohmann::json::object();
+    results["terminated"] = nlohmann::json::object();
+
+    // Output replay file for visualizer
+
+    // While compilers like G++4.8 report C++11 compatibility, they do not
+    // support std::put_time, so we have to use strftime instead.
+    const auto time = std::time(nullptr);
+    std::tm localtime{};
+#ifdef _WIN32
+    localtime_s(&localtime, &time);
+#else
+    localtime_r(&time, &localtime);
+#endif
+    static constexpr size_t MAX_DATE_STRING_LENGTH = 25;
+    char time_string[MAX_DATE_STRING_LENGTH];
+    std::strftime(time_string, MAX_DATE_STRING_LENGTH, "%Y%m%d-%H%M%S%z", &localtime);
+    // Games of a batch may share a seed and map size, so their files also carry the label.
+    const auto label_suffix = spec.label.empty() ? std::string() : "-" + spec.label;
+
+    game_statistics.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count();
+
+    if (config.write_replay) {
+        // Output gamefile. First try the replays folder; if that fails, just use the straight filename.
+        std::stringstream filename_buf;
+        filename_buf << "replay-" << std::string(time_string);
+        filename_buf << "-" << replay.map_generator_seed;
+        filename_buf << "-" << map.width;
+        filename_buf << "-" << map.height << label_suffix << ".hlt";
+        auto filename = filename_buf.str();
+        std::string output_filename = replay_directory + filename;
+        results["replay"] = output_filename;
+        try {
+            replay.output(output_filename, config.compress);
+        } catch (std::runtime_error &e) {
+            Logging::log("Error: could not write replay to directory " + replay_directory + ", falling back on current directory.", Logging::Level::Error);
+            replay_directory = "./";
+            output_filename = replay_directory + filename;
+            replay.output(output_filename, config.compress);
+        }
+        Logging::log("Opening a file at " + output_filename);
+    }
+
+    for (const auto &stats : replay.game_statistics.player_statistics) {
+        std::stringstream message;
+        message << "Player "
+                << to_string(stats.player_id)
+                << ", '"
+                << replay.players.at(stats.player_id).name
+                << "', was rank "
+                << std::to_string(stats.rank)
+                << " with "
+                << std::to_string(stats.turn_productions.back())
+                << " halite";
+        Logging::log(message.str());
+    }
+
+    for (const auto &[player_id, player] : replay.players) {
+        std::string error_log = game.logs.str(player_id);
+        if (!error_log.empty()) {
+            if (config.write_logs || player.terminated) {
+                std::stringstream logname_buf;
+                logname_buf << "errorlog-" << std::string(time_string)
+                            << "-" << replay.map_generator_seed
+                            << "-" << map_width
+                            << "-" << map_height
+                            << label_suffix
+                            << "-" << player_id
+                            << ".log";
+                const auto log_filename = logname_buf.str();
+                auto log_filepath = replay_directory + log_filename;
+
+                std::ofstream log_file;
+                log_file.open(log_filepath, std::ios_base::out);
+                if (!log_file.is_open()) {
+                    log_filepath = replay_directory + log_filename;
+                    log_file.open(log_filepath, std::ios_base::out);
+                }
+
+                results["error_logs"][to_string(player_id)] = log_filepath;
+                log_file.write(error_log.c_str(), error_log.size());
+                Logging::log("Player has log output. Writing a log at " + log_filepath,
+                             Logging::Level::Info, player.id);
+            }
+            else {
+                Logging::log("Player has log output, but log was suppressed.",
+                             Logging::Level::Info, player.id);
+            }
+            results["terminated"][to_string(player_id)] = player.terminated;
+        }
+    }
+
+    results["execution_time"] = game_statistics.execution_time;
+    results["map_width"] = map_width;
+    results["map_height"] = map_height;
+    results["map_total_halite"] = game_statistics.map_total_halite;
+    results["map_seed"] = spec.seed;
+    std::ostringstream stream;
+    stream << spec.map_type;
+    results["map_generator"] = stream.str();
+    results["final_snapshot"] = game.to_snapshot(map_parameters);
+    results["stats"] = nlohmann::json::object();
+    for (const auto &stats : replay.game_statistics.player_statistics) {
+        results["stats"][to_string(stats.player_id)] = {
+            {"rank", stats.rank},
+            {"score", stats.turn_productions.back()}
+        };
+    }
+    results["timing"] = timing_summary(game_statistics);
+    if (!spec.label.empty()) {
+        results["label"] = spec.label;
+    }
+    return results;
+}
+
+}
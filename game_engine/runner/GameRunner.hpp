@@ -0,0 +1,61 @@
+#ifndef GAMERUNNER_HPP
+#define GAMERUNNER_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Generator.hpp"
+
+#include "nlohmann/json.hpp"
+
+namespace net {
+class ConnectionPool;
+}
+
+namespace hlt {
+
+/** Output and networking options shared by all games run by one engine process. */
+struct RunnerConfig {
+    std::string replay_directory = "./"; /**< The directory for replays and logs, ending in a separator. */
+    bool write_replay = true;            /**< Whether to write the replay. */
+    bool write_logs = true;              /**< Whether to write player logs of players that were not terminated. */
+    bool compress = true;                /**< Whether to compress the replay. */
+    bool ignore_timeout = false;         /**< Whether to ignore bot timeouts. */
+    bool replay_timing = false;          /**< Whether to add the timing and traffic of every turn to the replay. */
+    net::ConnectionPool *pool{};         /**< Bots kept between games, or null to launch bots for each game. */
+};
+
+/** The description of a single game. */
+struct GameSpec {
+    unsigned int seed{};                                /**< The map seed. */
+    dimension_type width{};                             /**< The map width, or 0 for the default of the seed. */
+    dimension_type height{};                            /**< The map height, or 0 for the default of the seed. */
+    unsigned long num_players = 1;                      /**< The minimum number of players on the map. */
+    mapgen::MapType map_type = mapgen::MapType::Fractal; /**< The map type. */
+    std::vector<std::string> bot_commands;              /**< The start commands of the bots. */
+    std::vector<std::string> names;                     /**< Overrides for the names the bots send. */
+    unsigned long turn_limit{};                         /**< The maximum number of turns, or 0 for the default. */
+    std::string snapshot;                               /**< A snapshot to start from, if not empty. */
+    std::string label;                                  /**< Label for logs and output files, empty for a lone game. */
+};
+
+/**
+ * Run a game to completion and write its replay and logs.
+ *
+ * The game runs with a private copy of the current constants, and may run concurrently
+ * with other games on other threads.
+ *
+ * @param spec The game to run.
+ * @param config The output and networking options.
+ * @param start The time the game was requested, for the execution time.
+ * @return The results of the game, in the format used by the backend.
+ * @throws std::invalid_argument if the game has too many players.
+ * @throws SnapshotError if the snapshot is malformed.
+ */
+nlohmann::json run_game(const GameSpec &spec, const RunnerConfig &config,
+                        std::chrono::system_clock::time_point start = std::chrono::system_clock::now());
+
+}
+
+#endif // GAMERUNNER_HPP
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+
+#include "Logging.hpp"
+#include "Replay.hpp"
+#include "Resimulation.hpp"
+#include "Simulation.hpp"
+
+namespace hlt {
+
+namespace {
+
+/**
+ * Bring a replay frame into a canonical form for comparison. Cells and events are recorded
+ * in an order that depends on hashing, which may differ between builds of the engine.
+ * @param frame The frame.
+ * @return The canonical frame.
+ */
+nlohmann::json canonical_frame(nlohmann::json frame) {
+    for (const auto *key : {"cells", "events"}) {
+        auto &entries = frame[key];
+        std::vector<std::string> dumps;
+        for (const auto &entry : entries) {
+            dumps.emplace_back(entry.dump());
+        }
+        std::sort(dumps.begin(), dumps.end());
+        entries = dumps;
+    }
+    return frame;
+}
+
+}
+
+/**
+ * Convert a report to JSON format.
+ * @param[out] json The output JSON.
+ * @param report The report to convert.
+ */
+void to_json(nlohmann::json &json, const ResimulationReport &report) {
+    json = {{"turns",            report.turns},
+            {"seconds",          report.seconds},
+            {"turns_per_second", report.seconds > 0 ? report.turns / report.seconds : 0},
+            {"matches",          report.matches},
+            {"first_mismatch",   report.first_mismatch}};
+}
+
+/**
+ * Play the recorded commands of a game through the rules engine again, and check that
+ * every frame matches the recorded one.
+ * @param replay The replay, as read by Replay::read.
+ * @return The report.
+ * @throws nlohmann::json::exception if the replay is malformed.
+ */
+ResimulationReport resimulate(const nlohmann::json &replay) {
+    // The game runs with the recorded constants, whose turn limit was already adjusted to the map.
+    Constants::Scope scope;
+    auto &constants = Constants::get_mut();
+    from_json(replay.at("GAME_CONSTANTS"), constants);
+    constants.MIN_TURNS = constants.MAX_TURNS;
+
+    const auto &map_json = replay.at("production_map");
+    Map map(map_json.at("width").get<dimension_type>(), map_json.at("height").get<dimension_type>());
+    const auto &grid = map_json.at("grid");
+    for (dimension_type y = 0; y < map.height; y++) {
+        for (dimension_type x = 0; x < map.width; x++) {
+            map.at(x, y).energy = grid.at(y).at(x).at("energy").get<energy_type>();
+        }
+    }
+    // Players took the factories in ID order.
+    auto players = replay.at("players").get<std::vector<nlohmann::json>>();
+    std::sort(players.begin(), players.end(), [](const auto &first, const auto &second) {
+        return first.at("player_id").template get<id_value_type>() < second.at("player_id").template get<id_value_type>();
+    });
+    for (const auto &player : players) {
+        const auto &factory = player.at("factory_location");
+        map.factories.emplace_back(factory.at("x").get<dimension_type>(), factory.at("y").get<dimension_type>());
+    }
+
+    Simulation simulation(true);
+    simulation.init(map, replay.at("map_generator_seed").get<unsigned int>(), players.size());
+    const auto &frames = replay.at("full_frames");
+    const auto &played = simulation.get_replay().full_frames;
+
+    ResimulationReport report;
+    const auto check_frame = [&](size_t index) {
+        if (report.matches && (index >= frames.size() || index >= played.size()
+                               || canonical_frame(frames[index]) != canonical_frame(played[index]))) {
+            report.matches = false;
+            report.first_mismatch = static_cast<long>(index);
+        }
+    };
+    check_frame(0);
+
+    std::vector<bool> playing(players.size(), true);
+    std::chrono::steady_clock::duration elapsed{};
+    bool done = false;
+    // The last frame records the end of the game rather than a turn.
+    for (size_t index = 1; index + 1 < frames.size() && !done; index++) {
+        const auto &moves = frames[index].at("moves");
+        std::vector<Simulation::Commands> commands(players.size());
+        std::vector<Player::id_type> removed;
+        for (size_t player = 0; player < players.size(); player++) {
+            const auto moves_iterator = moves.find(std::to_string(player));
+            if (moves_iterator != moves.end()) {
+                for (const auto &command : *moves_iterator) {
+                    commands[player].emplace_back(command.get<Command>());
+                }
+            } else if (playing[player]) {
+                // Commands stop when a player is removed, for failing or for invalid commands.
+                playing[player] = false;
+                removed.emplace_back(static_cast<id_value_type>(player));
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        done = simulation.step(std::move(commands), removed);
+        elapsed += std::chrono::steady_clock::now() - start;
+        report.turns++;
+        check_frame(index);
+    }
+    if (!done || played.size() != frames.size()) {
+        check_frame(std::min(played.size(), frames.size()));
+    } else {
+        check_frame(frames.size() - 1);
+    }
+    report.seconds = std::chrono::duration<double>(elapsed).count();
+    return report;
+}
+
+}
@@ -0,0 +1,39 @@
+#ifndef RESIMULATION_HPP
+#define RESIMULATION_HPP
+
+#include "nlohmann/json.hpp"
+
+namespace hlt {
+
+/** Outcome of re-simulating a replay. */
+struct ResimulationReport {
+    unsigned long turns{};   /**< The number of turns played. */
+    double seconds{};        /**< The time spent playing turns, excluding the frame checks. */
+    bool matches = true;     /**< Whether every frame matched the recorded one. */
+    long first_mismatch = -1; /**< The index of the first frame that did not match, or -1. */
+
+    /**
+     * Convert a report to JSON format.
+     * @param[out] json The output JSON.
+     * @param report The report to convert.
+     */
+    friend void to_json(nlohmann::json &json, const ResimulationReport &report);
+};
+
+/**
+ * Play the recorded commands of a game through the rules engine again, without bots or
+ * networking, and check that every frame matches the recorded one.
+ *
+ * The game starts from the recorded map, seed and constants. Players are removed on the
+ * turn their recorded commands stop, as they were when their bots failed. Games started
+ * from a snapshot cannot be re-simulated, and report a mismatch on the first frame.
+ *
+ * @param replay The replay, as read by Replay::read.
+ * @return The report.
+ * @throws nlohmann::json::exception if the replay is malformed.
+ */
+ResimulationReport resimulate(const nlohmann::json &replay);
+
+}
+
+#endif // RESIMULATION_HPP
@@ -0,0 +1,165 @@
+#include "Simulation.hpp"
+
+#include "Halite.hpp"
+#include "HaliteImpl.hpp"
+#include "Replay.hpp"
+#include "Snapshot.hpp"
+
+namespace hlt {
+
+/**
+ * Construct Simulation, capturing the current constants for every game.
+ * @param record_replay Whether to keep the replay of each game.
+ */
+Simulation::Simulation(bool record_replay) : constants(Constants::get()), record_replay(record_replay) {}
+
+/** Discard the previous game, if any, and restore the constants for a new one. */
+void Simulation::reset() {
+    // The game references the map, statistics and replay, so it goes first.
+    game.reset();
+    replay.reset();
+    // Games adjust the constants to the map, so every game starts from the same ones.
+    from_json(constants, Constants::get_mut());
+}
+
+/**
+ * Start a new game on the current map.
+ * @param seed The map seed, which also seeds tie breaking.
+ * @param num_players The number of players.
+ */
+void Simulation::start(unsigned int seed, unsigned long num_players) {
+    game_statistics = std::make_unique<GameStatistics>();
+    replay = std::make_unique<Replay>(*game_statistics, num_players, seed, *map);
+    game = std::make_unique<Halite>(*map, net::NetworkingConfig{}, *game_statistics, *replay);
+
+    auto &impl = *game->impl;
+    impl.initialize_game(std::vector<std::string>(num_players), Snapshot{});
+    replay->players.insert(game->store.all_players().begin(), game->store.all_players().end());
+    game->turn_number = 1;
+    done = false;
+    if (!record_replay) {
+        replay->full_frames.clear();
+    }
+    update_observation();
+}
+
+/**
+ * Initialize a new game, discarding any previous one.
+ * @param map_parameters The map generation parameters.
+ * @param num_players The number of players.
+ */
+void Simulation::init(mapgen::MapParameters map_parameters, unsigned long num_players) {
+    reset();
+    map_parameters.num_players = num_players;
+    map = std::make_unique<Map>(map_parameters.width, map_parameters.height);
+    mapgen::Generator::generate(*map, map_parameters);
+    start(map_parameters.seed, num_players);
+}
+
+/**
+ * Initialize a new game on a given map, such as the map of a replay, discarding any previous one.
+ * @param initial_map The map, with its energy and factories.
+ * @param seed The map seed, which also seeds tie breaking.
+ * @param num_players The number of players.
+ */
+void Simulation::init(const Map &initial_map, unsigned int seed, unsigned long num_players) {
+    reset();
+    map = std::make_unique<Map>(initial_map);
+    start(seed, num_players);
+}
+
+/**
+ * Play one turn.
+ * @param commands The commands of each player for the turn, by player ID. Players may be
+ * missing from the end; the commands of players who are no longer playing are ignored.
+ * @param removed Players to remove from the game at the start of the turn, as the engine
+ * does when a bot crashes, times out or sends invalid commands.
+ * @return True if the game has ended.
+ */
+bool Simulation::step(std::vector<Commands> commands, const std::vector<Player::id_type> &removed) {
+    assert(game && !done);
+    auto &impl = *game->impl;
+    impl.start_turn();
+    for (const auto &player_id : removed) {
+        if (!game->store.get_player(player_id).terminated) {
+            impl.kill_player(player_id);
+        }
+    }
+    // Every player still playing has commands, even if empty, as if a bot had sent them.
+    impl.commands.clear();
+    for (const auto &[player_id, player] : game->store.all_players()) {
+        if (!player.terminated) {
+            auto &player_commands = impl.commands[player_id];
+            const auto index = static_cast<size_t>(player_id.value);
+            if (index < commands.size()) {
+                player_commands = std::move(commands[index]);
+            }
+        }
+    }
+    impl.process_commands();
+    const auto ended = impl.end_turn();
+    game->turn_number++;
+    if (ended || game->turn_number > Constants::get().MAX_TURNS) {
+        impl.end_game();
+        done = true;
+    }
+    if (!record_replay) {
+        replay->full_frames.clear();
+    }
+    update_observation();
+    return done;
+}
+
+/**
+ * Capture the rules state of the game, to branch from it later with restore().
+ * The game must not have ended.
+ * @return The checkpoint.
+ */
+Checkpoint Simulation::checkpoint() const {
+    assert(game && !done);
+    return game->checkpoint();
+}
+
+/**
+ * Return the game to a checkpoint taken from it, and update the observation.
+ * The replay and statistics keep the turns played since.
+ * @param checkpoint The checkpoint.
+ */
+void Simulation::restore(const Checkpoint &checkpoint) {
+    assert(game);
+    game->restore(checkpoint);
+    // Checkpoints are only taken of games in progress.
+    done = false;
+    update_observation();
+}
+
+/** Bring the observation up to date with the game. */
+void Simulation::update_observation() {
+    observation.turn_number = game->turn_number;
+    observation.done = done;
+    observation.map = map.get();
+    auto &store = game->store;
+    observation.players.resize(store.all_players().size());
+    auto player_observation = observation.players.begin();
+    for (const auto &[player_id, player] : store.all_players()) {
+        player_observation->id = player_id;
+        player_observation->factory = player.factory;
+        player_observation->energy = player.energy;
+        player_observation->terminated = player.terminated;
+        player_observation->dropoffs.clear();
+        for (const auto &dropoff : player.dropoffs) {
+            player_observation->dropoffs.push_back(dropoff.location);
+        }
+        player_observation->entities.clear();
+        for (const auto &[entity_id, location] : player.entities) {
+            const auto &entity = store.get_entity(entity_id);
+            player_observation->entities.push_back({entity_id, location, entity.energy, entity.is_inspired});
+        }
+        player_observation++;
+    }
+}
+
+/** Default destructor is defined where Halite is complete. */
+Simulation::~Simulation() = default;
+
+}
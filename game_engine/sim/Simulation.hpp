@@ -0,0 +1,154 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <memory>
+#include <vector>
+
+#include "Checkpoint.hpp"
+#include "Command.hpp"
+#include "Constants.hpp"
+#include "Generator.hpp"
+#include "Map.hpp"
+
+#include "nlohmann/json.hpp"
+
+namespace hlt {
+
+class Halite;
+
+struct GameStatistics;
+
+struct Replay;
+
+/** Observed state of an entity. */
+struct EntityObservation {
+    Entity::id_type id;   /**< The ID of the entity. */
+    Location location;    /**< The location of the entity. */
+    energy_type energy;   /**< The energy carried by the entity. */
+    bool is_inspired;     /**< Whether the entity is inspired. */
+};
+
+/** Observed state of a player. */
+struct PlayerObservation {
+    Player::id_type id{};                    /**< The ID of the player. */
+    Location factory{0, 0};                  /**< The location of the factory. */
+    energy_type energy{};                    /**< The energy stockpiled by the player. */
+    bool terminated{};                       /**< Whether the player was kicked out of the game. */
+    std::vector<Location> dropoffs;          /**< The locations of the dropoffs. */
+    std::vector<EntityObservation> entities; /**< The entities, in ID order. */
+};
+
+/** Observed state of a simulated game. */
+struct Observation {
+    unsigned long turn_number{};            /**< The number of the next turn to be played. */
+    bool done{};                            /**< Whether the game has ended. */
+    const Map *map{};                       /**< The map, with its energy, entity, owner and structure planes. */
+    std::vector<PlayerObservation> players; /**< The players, in ID order. */
+};
+
+/**
+ * Headless, in-process Halite game, for running the rules without bots.
+ *
+ * The game runs on the same rules engine as the halite executable, but no processes are
+ * launched, commands are given as objects rather than text, and the replay is only kept
+ * if requested. Games may be started over with init() as often as needed.
+ */
+class Simulation final {
+public:
+    /** The type of the command list of one player. */
+    using Commands = std::vector<Command>;
+
+private:
+    const nlohmann::json constants;                  /**< The constants before any game, restored by init(). */
+    const bool record_replay;                        /**< Whether to keep the replay. */
+    std::unique_ptr<Map> map;                        /**< The game map. */
+    std::unique_ptr<GameStatistics> game_statistics; /**< The statistics of the game. */
+    std::unique_ptr<Replay> replay;                  /**< The replay of the game. */
+    std::unique_ptr<Halite> game;                    /**< The game. */
+    bool done{};                                     /**< Whether the game has ended. */
+    Observation observation;                         /**< The observation, reused across turns. */
+
+    /** Bring the observation up to date with the game. */
+    void update_observation();
+
+    /** Discard the previous game, if any, and restore the constants for a new one. */
+    void reset();
+
+    /**
+     * Start a new game on the current map.
+     * @param seed The map seed, which also seeds tie breaking.
+     * @param num_players The number of players.
+     */
+    void start(unsigned int seed, unsigned long num_players);
+
+public:
+    /**
+     * Initialize a new game, discarding any previous one.
+     * @param map_parameters The map generation parameters.
+     * @param num_players The number of players.
+     */
+    void init(mapgen::MapParameters map_parameters, unsigned long num_players);
+
+    /**
+     * Initialize a new game on a given map, such as the map of a replay, discarding any previous one.
+     * @param initial_map The map, with its energy and factories.
+     * @param seed The map seed, which also seeds tie breaking.
+     * @param num_players The number of players.
+     */
+    void init(const Map &initial_map, unsigned int seed, unsigned long num_players);
+
+    /**
+     * Play one turn.
+     * @param commands The commands of each player for the turn, by player ID. Players may be
+     * missing from the end; the commands of players who are no longer playing are ignored.
+     * @param removed Players to remove from the game at the start of the turn, as the engine
+     * does when a bot crashes, times out or sends invalid commands.
+     * @return True if the game has ended.
+     */
+    bool step(std::vector<Commands> commands, const std::vector<Player::id_type> &removed = {});
+
+    /**
+     * Capture the rules state of the game, to branch from it later with restore().
+     * The game must not have ended.
+     * @return The checkpoint.
+     */
+    Checkpoint checkpoint() const;
+
+    /**
+     * Return the game to a checkpoint taken from it, and update the observation.
+     * The replay and statistics keep the turns played since.
+     * @param checkpoint The checkpoint.
+     */
+    void restore(const Checkpoint &checkpoint);
+
+    /**
+     * Observe the game. The observation is updated in place by later calls to init() and step().
+     * @return The observation.
+     */
+    const Observation &observe() const { return observation; }
+
+    /**
+     * Get the statistics of the game.
+     * @return The statistics.
+     */
+    const GameStatistics &statistics() const { return *game_statistics; }
+
+    /**
+     * Get the replay of the game. Only has frames if replay recording was requested.
+     * @return The replay.
+     */
+    const Replay &get_replay() const { return *replay; }
+
+    /**
+     * Construct Simulation, capturing the current constants for every game.
+     * @param record_replay Whether to keep the replay of each game.
+     */
+    explicit Simulation(bool record_replay = false);
+
+    /** Default destructor is defined where Halite is complete. */
+    ~Simulation();
+};
+
+}
+
+#endif // SIMULATION_HPP
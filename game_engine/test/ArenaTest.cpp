@@ -0,0 +1,46 @@
+#include "Arena.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("Arena hands out memory until reset", "[arena]") {
+    GIVEN("An arena with a small buffer") {
+        Arena arena(64);
+
+        WHEN("allocations fit in the buffer") {
+            auto *first = static_cast<std::byte *>(arena.allocate(16, 8));
+            auto *second = static_cast<std::byte *>(arena.allocate(16, 16));
+            THEN("they are aligned and do not overlap") {
+                REQUIRE(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+                REQUIRE(second >= first + 16);
+            }
+            AND_WHEN("the arena is reset") {
+                arena.reset();
+                THEN("memory is reused and the capacity is kept") {
+                    REQUIRE(arena.allocate(16, 8) == first);
+                    REQUIRE(arena.capacity() == 64);
+                }
+            }
+        }
+
+        WHEN("allocations spill over the buffer") {
+            std::pmr::vector<long> values(&arena);
+            for (long value = 0; value < 100; value++) {
+                values.push_back(value);
+            }
+            THEN("the values are intact") {
+                for (long value = 0; value < 100; value++) {
+                    REQUIRE(values[value] == value);
+                }
+            }
+            AND_WHEN("the arena is reset") {
+                values = std::pmr::vector<long>(&arena);
+                arena.reset();
+                THEN("the buffer grows to cover the spill") {
+                    REQUIRE(arena.capacity() >= 100 * sizeof(long));
+                }
+            }
+        }
+    }
+}
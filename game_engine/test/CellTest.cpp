@@ -1,4 +1,5 @@
 #include "Cell.hpp"
+#include "Map.hpp"
 
 #include "catch.hpp"
 
@@ -10,6 +11,7 @@ SCENARIO("Cell is initialized correctly", "[cell]") {
         REQUIRE(cell.energy == 0);
         REQUIRE(cell.entity == Entity::None);
         REQUIRE(cell.owner == Player::None);
+        REQUIRE(cell.structure == Player::NO_STRUCTURE);
         WHEN("converted to json") {
             nlohmann::json json;
             to_json(json, cell);
@@ -46,3 +48,35 @@ SCENARIO("Cell is initialized correctly", "[cell]") {
         }
     }
 }
+
+SCENARIO("Map cells refer into the planes of the map", "[cell]") {
+    GIVEN("A new map") {
+        Map map(8, 4);
+        THEN("every cell is empty") {
+            REQUIRE(map.at(7, 3).energy == 0);
+            REQUIRE(map.at(7, 3).entity == Entity::None);
+            REQUIRE(map.at(7, 3).owner == Player::None);
+            REQUIRE(map.at(7, 3).structure == Player::NO_STRUCTURE);
+        }
+        WHEN("a cell is updated through a reference") {
+            auto cell = map.at({5, 2});
+            cell.energy = 10;
+            cell.entity = Entity::id_type(2);
+            cell.owner = Player::id_type(3);
+            cell.structure = Player::FACTORY;
+            THEN("the planes hold the new values") {
+                REQUIRE(map.energy.at(5, 2) == 10);
+                REQUIRE(map.entity.at(5, 2) == Entity::id_type(2));
+                REQUIRE(map.owner.at(5, 2) == Player::id_type(3));
+                REQUIRE(map.structure.at(5, 2) == Player::FACTORY);
+                REQUIRE(map.total_energy() == 10);
+            }
+            THEN("the cell can be copied out") {
+                const Cell copy = map[{5, 2}];
+                REQUIRE(copy.energy == 10);
+                REQUIRE(copy.entity == Entity::id_type(2));
+                REQUIRE(copy.owner == Player::id_type(3));
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Simulation.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+/** The number of allocations made by the test program, to check that restores do not allocate. */
+static std::atomic<long> allocations{0};
+
+/**
+ * Allocate memory, counting the allocation.
+ * @param size The size to allocate.
+ * @return The memory, or null if it could not be allocated.
+ */
+static void *counted_allocate(std::size_t size) noexcept {
+    allocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+/**
+ * Allocate memory, counting the allocation. Every form of operator new and delete is
+ * replaced, so that memory is always freed by the allocator that allocated it.
+ * @param size The size to allocate.
+ * @return The memory.
+ */
+void *operator new(std::size_t size) {
+    if (auto *pointer = counted_allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return counted_allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return counted_allocate(size);
+}
+
+/**
+ * Free memory allocated by operator new.
+ * @param pointer The memory.
+ */
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Append values to a flattened observation.
+ * @param values The flattened observation.
+ * @param appended The values to append.
+ */
+template<typename... Values>
+static void append(std::vector<long long> &values, Values... appended) {
+    (values.push_back(static_cast<long long>(appended)), ...);
+}
+
+/**
+ * Flatten an observation, with the map planes it points to, for comparison.
+ * @param observation The observation.
+ * @return The observed values.
+ */
+static std::vector<long long> flatten(const Observation &observation) {
+    std::vector<long long> values{static_cast<long long>(observation.turn_number)};
+    const auto &map = *observation.map;
+    for (dimension_type y = 0; y < map.height; y++) {
+        for (dimension_type x = 0; x < map.width; x++) {
+            const auto cell = map.at(x, y);
+            append(values, cell.energy, cell.entity.value, cell.owner.value, cell.structure);
+        }
+    }
+    for (const auto &player : observation.players) {
+        append(values, player.energy, player.terminated);
+        for (const auto &dropoff : player.dropoffs) {
+            append(values, dropoff.x, dropoff.y);
+        }
+        for (const auto &entity : player.entities) {
+            append(values, entity.id.value, entity.location.x, entity.location.y, entity.energy);
+        }
+    }
+    return values;
+}
+
+SCENARIO("A game can be restored to a checkpoint", "[checkpoint]") {
+    const mapgen::MapParameters map_parameters{mapgen::MapType::Fractal, 42, 32, 32, 0};
+
+    GIVEN("A game with two players and a ship out mining") {
+        Simulation simulation;
+        simulation.init(map_parameters, 2);
+        const auto &observation = simulation.observe();
+        std::vector<Simulation::Commands> commands(1);
+        commands[0].emplace_back(SpawnCommand());
+        simulation.step(std::move(commands));
+        const auto ship = observation.players[0].entities.front().id;
+        commands.assign(1, {});
+        commands[0].emplace_back(MoveCommand(ship, Direction::North));
+        simulation.step(std::move(commands));
+        simulation.step({});
+
+        const auto checkpoint = simulation.checkpoint();
+        const auto before = flatten(observation);
+
+        /** Play on until the first player spends all it has on a dropoff, which ends the game. */
+        const auto play_on = [&simulation, &observation, ship]() {
+            std::vector<Simulation::Commands> branch(2);
+            branch[0].emplace_back(MoveCommand(ship, Direction::East));
+            branch[1].emplace_back(SpawnCommand());
+            simulation.step(std::move(branch));
+            branch.assign(2, {});
+            branch[0].emplace_back(ConstructCommand(ship));
+            simulation.step(std::move(branch));
+            return observation.players[1].entities.front().id;
+        };
+
+        WHEN("the game moves on") {
+            const auto spawned = play_on();
+            const auto after = flatten(observation);
+            REQUIRE(observation.players[0].dropoffs.size() == 1);
+            REQUIRE(observation.done);
+            REQUIRE(after != before);
+
+            AND_WHEN("the checkpoint is restored") {
+                const auto allocated = allocations.load();
+                simulation.restore(checkpoint);
+                const auto restore_allocations = allocations.load() - allocated;
+                THEN("the state is as it was") {
+                    REQUIRE(observation.turn_number == checkpoint.turn_number());
+                    REQUIRE(!observation.done);
+                    REQUIRE(observation.players[0].dropoffs.empty());
+                    REQUIRE(observation.players[1].entities.empty());
+                    REQUIRE(flatten(observation) == before);
+                }
+                THEN("new IDs continue from the checkpoint") {
+                    REQUIRE(play_on() == spawned);
+                    REQUIRE(flatten(observation) == after);
+                }
+                THEN("the storage of the game was reused") {
+                    REQUIRE(restore_allocations == 0);
+                }
+                THEN("restoring again is idempotent") {
+                    play_on();
+                    simulation.restore(checkpoint);
+                    REQUIRE(flatten(observation) == before);
+                    REQUIRE(checkpoint.turn_number() == 4);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <sstream>
+
+#include "BotCommunicationError.hpp"
+#include "CommandParser.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+/**
+ * Decode a line through stream extraction, as the engine used to.
+ * @param input The line.
+ * @return The commands in bot serial format, or the error message.
+ */
+static std::vector<std::string> parse_with_stream(const std::string &input) {
+    std::vector<std::string> result;
+    try {
+        std::istringstream stream(input);
+        Command command;
+        while (stream >> command) {
+            result.push_back(to_bot_serial(command));
+        }
+    } catch (const BotCommunicationError &error) {
+        result = {error.what()};
+    }
+    return result;
+}
+
+/**
+ * Decode a line with CommandParser.
+ * @param parser The parser.
+ * @param input The line.
+ * @return The commands in bot serial format, or the error message.
+ */
+static std::vector<std::string> parse_with_parser(CommandParser &parser, const std::string &input) {
+    std::vector<std::string> result;
+    try {
+        for (const auto &command : parser.parse(input)) {
+            result.push_back(to_bot_serial(command));
+        }
+    } catch (const BotCommunicationError &error) {
+        result.emplace_back(error.what());
+    }
+    return result;
+}
+
+SCENARIO("CommandParser decodes lines as stream extraction does", "[command_parser]") {
+    GIVEN("A parser reused across lines") {
+        CommandParser parser;
+
+        WHEN("well-formed and malformed lines are decoded") {
+            const std::vector<std::string> lines{
+                    "",
+                    "   ",
+                    "g",
+                    "m 1 n",
+                    "m 12 s g c 7 m 3 o",
+                    "  m\t4\te \r",
+                    "m +5 w",
+                    "m -2 n",
+                    "m 007 e",
+                    "m 5 nm 6 s",
+                    "c 3",
+                    "c",
+                    "c x g",
+                    "c +-3 g",
+                    "c 99999999999999999999 g",
+                    "g x",
+                    "m 1 n q",
+                    "m 5 n5",
+                    "m 1 z",
+                    "gc 1 g",
+            };
+
+            THEN("the commands and error messages match, including error positions") {
+                for (const auto &line : lines) {
+                    INFO("line: \"" << line << "\"");
+                    REQUIRE(parse_with_parser(parser, line) == parse_with_stream(line));
+                }
+            }
+        }
+
+        WHEN("a move is missing its entity or direction") {
+            THEN("decoding fails") {
+                REQUIRE_THROWS_AS(parser.parse("m"), BotCommunicationError);
+                REQUIRE_THROWS_AS(parser.parse("m 3"), BotCommunicationError);
+                REQUIRE_THROWS_AS(parser.parse("m x n"), BotCommunicationError);
+            }
+        }
+    }
+}
+
+/**
+ * Encode an entity ID in the binary protocol.
+ * @param id The ID.
+ * @return The ID as a 32-bit little-endian integer.
+ */
+static std::string binary_id(std::uint32_t id) {
+    std::string bytes;
+    for (size_t i = 0; i < 4; i++) {
+        bytes += static_cast<char>((id >> (8 * i)) & 0xFF);
+    }
+    return bytes;
+}
+
+SCENARIO("CommandParser decodes binary records", "[command_parser]") {
+    GIVEN("A parser") {
+        CommandParser parser;
+
+        WHEN("a record of every command is decoded") {
+            const auto record = "m" + binary_id(12) + "s" + "g" + "c" + binary_id(70000) + "m" + binary_id(3) + "o";
+
+            THEN("the commands match those of the text protocol") {
+                std::vector<std::string> result;
+                for (const auto &command : parser.parse_binary(record)) {
+                    result.push_back(to_bot_serial(command));
+                }
+                REQUIRE(result == parse_with_parser(parser, "m 12 s g c 70000 m 3 o"));
+            }
+        }
+
+        WHEN("an empty record is decoded") {
+            THEN("there are no commands") {
+                REQUIRE(parser.parse_binary("").empty());
+            }
+        }
+
+        WHEN("a record is malformed") {
+            THEN("decoding fails") {
+                REQUIRE_THROWS_AS(parser.parse_binary("x"), BotCommunicationError);
+                REQUIRE_THROWS_AS(parser.parse_binary("m" + binary_id(1)), BotCommunicationError);
+                REQUIRE_THROWS_AS(parser.parse_binary("m" + binary_id(1) + "z"), BotCommunicationError);
+                REQUIRE_THROWS_AS(parser.parse_binary("c" + binary_id(1).substr(0, 3)), BotCommunicationError);
+            }
+        }
+    }
+}
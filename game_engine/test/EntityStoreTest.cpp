@@ -0,0 +1,51 @@
+#include "EntityStore.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("EntityStore finds entities by ID as they are added and removed", "[entity_store]") {
+    GIVEN("A store with three entities") {
+        Factory<Entity> factory;
+        EntityStore store;
+        const auto first = store.insert(factory.make(player_id_type(0), 10)).id;
+        const auto second = store.insert(factory.make(player_id_type(1), 20)).id;
+        const auto third = store.insert(factory.make(player_id_type(0), 30)).id;
+        REQUIRE(store.size() == 3);
+        REQUIRE(store.find(second)->energy == 20);
+        REQUIRE(store.find(Entity::id_type(3)) == nullptr);
+        REQUIRE(store.find(Entity::None) == nullptr);
+
+        WHEN("an entity in the middle is removed") {
+            store.erase(second);
+            THEN("it is gone and the others are still found") {
+                REQUIRE(store.size() == 2);
+                REQUIRE(store.find(second) == nullptr);
+                REQUIRE(store.find(first)->energy == 10);
+                REQUIRE(store.find(third)->energy == 30);
+                REQUIRE(store.find(third)->owner == player_id_type(0));
+            }
+            AND_WHEN("another entity is added") {
+                const auto fourth = store.insert(factory.make(player_id_type(1), 40)).id;
+                THEN("it gets a new ID and iteration visits every entity once") {
+                    REQUIRE(fourth == Entity::id_type(3));
+                    energy_type total = 0;
+                    for (const auto &entity : store) {
+                        total += entity.energy;
+                    }
+                    REQUIRE(total == 80);
+                }
+            }
+        }
+
+        WHEN("every entity is removed") {
+            store.erase(third);
+            store.erase(first);
+            store.erase(second);
+            THEN("the store is empty") {
+                REQUIRE(store.size() == 0);
+                REQUIRE(store.begin() == store.end());
+            }
+        }
+    }
+}
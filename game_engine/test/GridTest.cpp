@@ -59,3 +59,33 @@ SCENARIO("Grid constructor initializes member variables", "[grid]") {
         }
     }
 }
+
+SCENARIO("Grid with a power of two stride pads its rows", "[grid]") {
+    GIVEN("A 40x24 grid with a power of two stride") {
+        Grid<int> grid(40, 24, true);
+        REQUIRE(grid.width == 40);
+        REQUIRE(grid.height == 24);
+        REQUIRE(grid.stride == 64);
+        REQUIRE(grid.grid.size() == 64 * 24);
+        WHEN("cells are updated") {
+            grid.at(39, 0) = 1;
+            grid.at({0, 1}) = 2;
+            grid[{39, 23}] = 3;
+            THEN("rows start at multiples of the stride") {
+                REQUIRE(grid.grid[39] == 1);
+                REQUIRE(grid.grid[64] == 2);
+                REQUIRE(grid.row(1)[0] == 2);
+                REQUIRE(grid.grid[23 * 64 + 39] == 3);
+            }
+        }
+    }
+
+    GIVEN("A 40x24 grid without padding") {
+        const Grid<int> grid(40, 24);
+        THEN("rows are packed") {
+            REQUIRE(grid.stride == 40);
+            REQUIRE(grid.grid.size() == 40 * 24);
+            REQUIRE(grid.index(0, 1) == 40);
+        }
+    }
+}
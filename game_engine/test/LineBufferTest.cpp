@@ -0,0 +1,116 @@
+#ifndef _WIN32
+
+#include "LineBuffer.hpp"
+
+#include "catch.hpp"
+
+using namespace net;
+
+/**
+ * Make a line of distinguishable characters.
+ * @param length The length of the line.
+ * @param seed The seed of the characters.
+ * @return The line, without a newline.
+ */
+static std::string make_line(size_t length, size_t seed) {
+    std::string line(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        line[i] = static_cast<char>('a' + (seed + i) % 26);
+    }
+    return line;
+}
+
+SCENARIO("LineBuffer splits bytes into lines", "[line_buffer]") {
+    GIVEN("An empty buffer") {
+        LineBuffer lines;
+        std::string_view line;
+
+        WHEN("lines arrive in pieces") {
+            lines.append("first\nsec", 9);
+
+            THEN("complete lines are taken, and the rest waits for its newline") {
+                REQUIRE(lines.pop(line));
+                REQUIRE(line == "first");
+                REQUIRE_FALSE(lines.pop(line));
+                REQUIRE(lines.partial() == "sec");
+
+                lines.append("ond\n\nthird", 10);
+                REQUIRE(lines.pop(line));
+                REQUIRE(line == "second");
+                REQUIRE(lines.pop(line));
+                REQUIRE(line.empty());
+                REQUIRE_FALSE(lines.pop(line));
+                REQUIRE(lines.partial() == "third");
+            }
+        }
+
+        WHEN("lines are read into reserved space") {
+            const auto [space, length] = lines.reserve();
+            REQUIRE(length > 0);
+            space[0] = 'g';
+            space[1] = '\n';
+            lines.commit(2);
+
+            THEN("the line is taken") {
+                REQUIRE(lines.pop(line));
+                REQUIRE(line == "g");
+            }
+        }
+
+        WHEN("many lines pass through, wrapping around the ring") {
+            THEN("each line is taken whole") {
+                for (size_t i = 0; i < 300; i++) {
+                    const auto expected = make_line(1000 + i * 7, i);
+                    // Deliver each line in two pieces, with the newline in the second
+                    lines.append(expected.data(), expected.size() / 2);
+                    REQUIRE_FALSE(lines.pop(line));
+                    const auto rest = expected.substr(expected.size() / 2) + "\n";
+                    lines.append(rest.data(), rest.size());
+                    REQUIRE(lines.pop(line));
+                    REQUIRE(line == expected);
+                }
+            }
+        }
+
+        WHEN("records arrive in pieces, wrapping around the ring") {
+            THEN("each record is taken whole once its length and bytes have arrived") {
+                for (size_t i = 0; i < 300; i++) {
+                    const auto expected = make_line(1000 + i * 7, i) + '\n' + '\0';
+                    std::string length;
+                    for (size_t byte = 0; byte < 4; byte++) {
+                        length += static_cast<char>((expected.size() >> (8 * byte)) & 0xFF);
+                    }
+                    lines.append(length.data(), 2);
+                    REQUIRE_FALSE(lines.pop(line, Framing::Record));
+                    lines.append(length.data() + 2, 2);
+                    lines.append(expected.data(), expected.size() - 1);
+                    REQUIRE_FALSE(lines.pop(line, Framing::Record));
+                    lines.append(expected.data() + expected.size() - 1, 1);
+                    REQUIRE(lines.pop(line, Framing::Record));
+                    REQUIRE(line == expected);
+                }
+            }
+        }
+
+        WHEN("a line longer than the ring arrives in pipe-sized reads") {
+            const auto expected = make_line(3 * 1024 * 1024, 0);
+            static constexpr size_t READ_SIZE = 4096;
+            for (size_t offset = 0; offset < expected.size(); offset += READ_SIZE) {
+                lines.append(expected.data() + offset, std::min(READ_SIZE, expected.size() - offset));
+                REQUIRE_FALSE(lines.pop(line));
+            }
+            lines.append("\nnext\n", 6);
+
+            THEN("the ring grows to hold it, and the lines after it follow") {
+                REQUIRE(lines.pop(line));
+                REQUIRE(line == expected);
+                REQUIRE(lines.pop(line));
+                REQUIRE(line == "next");
+                REQUIRE_FALSE(lines.pop(line));
+                REQUIRE(lines.partial().empty());
+            }
+        }
+    }
+}
+
+#endif // _WIN32
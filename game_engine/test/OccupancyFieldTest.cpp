@@ -0,0 +1,68 @@
+#include <random>
+
+#include "OccupancyField.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+/**
+ * Count occupants within a radius by checking every cell of the grid.
+ * @param occupied The occupied cells.
+ * @param width The grid width.
+ * @param height The grid height.
+ * @param radius The radius.
+ * @param center The cell to count around.
+ * @return The number of occupants within the radius.
+ */
+static unsigned long brute_force_count(const std::vector<Location> &occupied,
+                                       dimension_type width, dimension_type height,
+                                       dimension_type radius, const Location &center) {
+    unsigned long count = 0;
+    for (const auto &location : occupied) {
+        const auto x_distance = std::abs(location.x - center.x);
+        const auto y_distance = std::abs(location.y - center.y);
+        const auto distance = std::min(x_distance, width - x_distance) + std::min(y_distance, height - y_distance);
+        if (distance <= std::max(radius, dimension_type{0})) {
+            count++;
+        }
+    }
+    return count;
+}
+
+SCENARIO("OccupancyField counts occupants within a radius on a wrap-around grid", "[occupancy_field]") {
+    std::mt19937 rng(42);
+    // Both regular maps and maps too small for the radius, where offsets alias.
+    const std::vector<std::tuple<dimension_type, dimension_type, dimension_type>> configurations{
+            {32, 32, 3}, {40, 24, 4}, {8, 8, 0}, {9, 7, 3}, {5, 5, 4}, {3, 12, 2}, {1, 1, 2}
+    };
+    for (const auto &[width, height, radius] : configurations) {
+        GIVEN("A " + std::to_string(width) + "x" + std::to_string(height) +
+              " grid with radius " + std::to_string(radius)) {
+            static constexpr size_t LAYERS = 3;
+            std::vector<std::vector<Location>> occupied(LAYERS);
+            OccupancyField field;
+            field.reset(width, height, LAYERS, radius);
+            for (size_t layer = 0; layer < LAYERS; layer++) {
+                const auto occupants = static_cast<int>(width * height / 4 + 1);
+                for (int i = 0; i < occupants; i++) {
+                    Location location{static_cast<dimension_type>(rng() % width),
+                                      static_cast<dimension_type>(rng() % height)};
+                    occupied[layer].push_back(location);
+                    field.add(layer, location);
+                }
+            }
+            field.compute();
+            THEN("every cell matches a brute force count") {
+                for (size_t layer = 0; layer < LAYERS; layer++) {
+                    for (dimension_type y = 0; y < height; y++) {
+                        for (dimension_type x = 0; x < width; x++) {
+                            REQUIRE(field.count(layer, {x, y}) ==
+                                    brute_force_count(occupied[layer], width, height, radius, {x, y}));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -61,6 +61,57 @@ SCENARIO("Players are initialized correctly", "[player]") {
     }
 }
 
+/**
+ * List the entities of a player in iteration order.
+ * @param player The player.
+ * @return The entity IDs.
+ */
+static std::vector<id_value_type> entity_ids(const Player &player) {
+    std::vector<id_value_type> ids;
+    for (const auto &[id, _] : player.entities) {
+        ids.push_back(id.value);
+    }
+    return ids;
+}
+
+SCENARIO("Player entities stay in ID order as they move and change hands", "[player]") {
+    GIVEN("A player with several entities") {
+        Player player(Player::id_type(0), Location(0, 0), "bot");
+        for (id_value_type id = 1; id <= 6; id++) {
+            player.add_entity(Entity::id_type(id), Location(id, 0));
+        }
+
+        WHEN("entities are removed and added back elsewhere, as moving ships are") {
+            player.remove_entity(Entity::id_type(2));
+            player.remove_entity(Entity::id_type(5));
+            REQUIRE(entity_ids(player) == std::vector<id_value_type>{1, 3, 4, 6});
+            player.add_entity(Entity::id_type(5), Location(5, 1));
+            player.add_entity(Entity::id_type(2), Location(2, 1));
+
+            THEN("they keep their place, at their new locations") {
+                REQUIRE(entity_ids(player) == std::vector<id_value_type>{1, 2, 3, 4, 5, 6});
+                REQUIRE(player.get_entity_location(Entity::id_type(2)) == Location(2, 1));
+                REQUIRE(player.entities.size() == 6);
+            }
+        }
+
+        WHEN("most entities are removed, and new and captured entities are added") {
+            for (id_value_type id = 1; id <= 5; id++) {
+                player.remove_entity(Entity::id_type(id));
+            }
+            player.add_entity(Entity::id_type(9), Location(9, 0));
+            player.add_entity(Entity::id_type(7), Location(7, 0));
+
+            THEN("the entities are in ID order, and removed ones are gone") {
+                REQUIRE(entity_ids(player) == std::vector<id_value_type>{6, 7, 9});
+                REQUIRE_FALSE(player.has_entity(Entity::id_type(3)));
+                REQUIRE(player.get_entity_location(Entity::id_type(7)) == Location(7, 0));
+                REQUIRE(player.entities.size() == 3);
+            }
+        }
+    }
+}
+
 SCENARIO("Players are encoded to JSON and bot serial format correctly", "[player_serial]") {
     GIVEN("An empty player") {
         Player player(Player::id_type(0), Location(0, 0), "bot");
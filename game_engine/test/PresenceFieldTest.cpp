@@ -0,0 +1,79 @@
+#include <random>
+
+#include "PresenceField.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+/**
+ * Find the distance to the nearest source by checking every source.
+ * @param sources The sources.
+ * @param width The grid width.
+ * @param height The grid height.
+ * @param center The cell to measure from.
+ * @return The distance to the nearest source, or -1 if there are none.
+ */
+static dimension_type brute_force_distance(const std::vector<Location> &sources,
+                                           dimension_type width, dimension_type height,
+                                           const Location &center) {
+    dimension_type nearest = -1;
+    for (const auto &location : sources) {
+        const auto x_distance = std::abs(location.x - center.x);
+        const auto y_distance = std::abs(location.y - center.y);
+        const auto distance = std::min(x_distance, width - x_distance) + std::min(y_distance, height - y_distance);
+        if (nearest < 0 || distance < nearest) {
+            nearest = distance;
+        }
+    }
+    return nearest;
+}
+
+SCENARIO("PresenceField finds the nearest source within a radius on a wrap-around grid", "[presence_field]") {
+    std::mt19937 rng(7);
+    const std::vector<std::tuple<dimension_type, dimension_type, dimension_type>> configurations{
+            {32, 32, 2}, {40, 24, 3}, {8, 8, 0}, {5, 5, 4}, {3, 12, 2}, {1, 1, 2}
+    };
+    for (const auto &[width, height, radius] : configurations) {
+        GIVEN("A " + std::to_string(width) + "x" + std::to_string(height) +
+              " grid with radius " + std::to_string(radius)) {
+            static constexpr size_t LAYERS = 3;
+            std::vector<std::vector<Location>> sources(LAYERS);
+            PresenceField field;
+            // Fill the field once first, to check that reset clears it.
+            field.reset(width, height, LAYERS, radius);
+            field.add(0, {0, 0});
+            field.compute();
+            field.reset(width, height, LAYERS, radius);
+            for (size_t layer = 1; layer < LAYERS; layer++) {
+                const auto count = static_cast<int>(rng() % 4);
+                for (int i = 0; i < count; i++) {
+                    Location location{static_cast<dimension_type>(rng() % width),
+                                      static_cast<dimension_type>(rng() % height)};
+                    sources[layer].push_back(location);
+                    field.add(layer, location);
+                }
+            }
+            field.compute();
+            THEN("every cell matches a brute force search") {
+                for (dimension_type y = 0; y < height; y++) {
+                    for (dimension_type x = 0; x < width; x++) {
+                        std::vector<bool> in_range(LAYERS);
+                        for (size_t layer = 0; layer < LAYERS; layer++) {
+                            const auto nearest = brute_force_distance(sources[layer], width, height, {x, y});
+                            in_range[layer] = nearest >= 0 && nearest <= radius;
+                            REQUIRE(field.distance(layer, {x, y}) == (in_range[layer] ? nearest : radius + 1));
+                        }
+                        for (size_t layer = 0; layer < LAYERS; layer++) {
+                            bool other = false;
+                            for (size_t other_layer = 0; other_layer < LAYERS; other_layer++) {
+                                other = other || (other_layer != layer && in_range[other_layer]);
+                            }
+                            REQUIRE(field.other_present(layer, {x, y}) == other);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include <random>
+
+#include "ProximityField.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("ProximityField tracks occupants within a radius as they come and go", "[proximity_field]") {
+    GIVEN("A field on a grid narrower than the radius square") {
+        ProximityField field;
+        field.reset(3, 8, 2, 2);
+        field.add(0, {0, 0});
+
+        THEN("an occupant reached both ways around the grid counts twice") {
+            REQUIRE(field.count(0, {1, 0}) == 2);
+            REQUIRE(field.total({1, 0}) == 2);
+            REQUIRE(field.count(1, {1, 0}) == 0);
+        }
+
+        THEN("removing the occupant clears its counts") {
+            field.remove(0, {0, 0});
+            REQUIRE(field.count(0, {1, 0}) == 0);
+            REQUIRE(field.total({0, 0}) == 0);
+        }
+    }
+
+    GIVEN("A field with occupants added and removed at random") {
+        static constexpr dimension_type WIDTH = 24, HEIGHT = 16, RADIUS = 4;
+        static constexpr size_t LAYERS = 3;
+        std::mt19937 rng(7);
+        ProximityField field;
+        field.reset(WIDTH, HEIGHT, LAYERS, RADIUS);
+        std::vector<std::vector<Location>> occupied(LAYERS);
+        for (int i = 0; i < 500; i++) {
+            const auto layer = rng() % LAYERS;
+            auto &locations = occupied[layer];
+            if (!locations.empty() && rng() % 3 == 0) {
+                const auto index = rng() % locations.size();
+                field.remove(layer, locations[index]);
+                locations.erase(locations.begin() + index);
+            } else {
+                Location location{static_cast<dimension_type>(rng() % WIDTH),
+                                  static_cast<dimension_type>(rng() % HEIGHT)};
+                field.add(layer, location);
+                locations.push_back(location);
+            }
+        }
+
+        THEN("every cell matches a brute force count") {
+            for (dimension_type y = 0; y < HEIGHT; y++) {
+                for (dimension_type x = 0; x < WIDTH; x++) {
+                    long total = 0;
+                    for (size_t layer = 0; layer < LAYERS; layer++) {
+                        long count = 0;
+                        for (const auto &location : occupied[layer]) {
+                            const auto x_distance = std::abs(location.x - x);
+                            const auto y_distance = std::abs(location.y - y);
+                            if (std::min(x_distance, WIDTH - x_distance) +
+                                std::min(y_distance, HEIGHT - y_distance) <= RADIUS) {
+                                count++;
+                            }
+                        }
+                        REQUIRE(field.count(layer, {x, y}) == count);
+                        total += count;
+                    }
+                    REQUIRE(field.total({x, y}) == total);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#ifdef __linux__
+
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+#include "NetworkingError.hpp"
+#include "Reactor.hpp"
+#include "TimeoutError.hpp"
+#include "UnixConnection.hpp"
+
+#include "catch.hpp"
+
+using namespace net;
+using namespace std::chrono_literals;
+
+/** The pipes standing in for a bot. */
+struct BotPipes {
+    int input[2]{};  /**< The stdin pipe. */
+    int output[2]{}; /**< The stdout pipe. */
+    int errors[2]{}; /**< The stderr pipe. */
+    Reactor::Channel channel{};
+
+    BotPipes() {
+        REQUIRE(pipe2(input, O_NONBLOCK | O_CLOEXEC) == 0);
+        REQUIRE(pipe2(output, O_NONBLOCK | O_CLOEXEC) == 0);
+        REQUIRE(pipe2(errors, O_NONBLOCK | O_CLOEXEC) == 0);
+        channel = Reactor::get().add(output[0], input[1], errors[0]);
+    }
+
+    void write_output(const std::string &text) const {
+        REQUIRE(write(output[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+    }
+
+    ~BotPipes() {
+        Reactor::get().remove(channel);
+        for (auto pipe : {input[0], input[1], output[0], output[1], errors[0], errors[1]}) {
+            close(pipe);
+        }
+    }
+};
+
+SCENARIO("Reactor splits bot output into lines", "[reactor]") {
+    GIVEN("A registered bot") {
+        BotPipes bot;
+        auto &reactor = Reactor::get();
+
+        WHEN("several lines arrive in pieces") {
+            bot.write_output("first\nsec");
+            const std::string first(reactor.read_line(bot.channel, 1000ms).get().message);
+            std::thread writer([&bot] {
+                std::this_thread::sleep_for(10ms);
+                bot.write_output("ond\n\nthird");
+            });
+            const std::string second(reactor.read_line(bot.channel, 1000ms).get().message);
+            writer.join();
+            const std::string third(reactor.read_line(bot.channel, 1000ms).get().message);
+
+            THEN("each read returns the next whole line") {
+                REQUIRE(first == "first");
+                REQUIRE(second == "second");
+                REQUIRE(third.empty());
+            }
+            AND_THEN("an unfinished line times out with the input so far") {
+                try {
+                    reactor.read_line(bot.channel, 20ms).get();
+                    FAIL("read did not time out");
+                } catch (const TimeoutError &err) {
+                    REQUIRE(err.remaining_input == "third");
+                }
+            }
+        }
+
+        WHEN("the bot closes its output") {
+            bot.write_output("partial");
+            close(bot.output[1]);
+            bot.output[1] = -1;
+
+            THEN("the read fails with the input so far") {
+                try {
+                    reactor.read_line(bot.channel, std::nullopt).get();
+                    FAIL("read did not fail");
+                } catch (const NetworkingError &err) {
+                    REQUIRE(err.remaining_input == "partial");
+                }
+            }
+        }
+
+        WHEN("the bot writes to stderr") {
+            const std::string message = "something went wrong\n";
+            REQUIRE(write(bot.errors[1], message.data(), message.size()) == static_cast<ssize_t>(message.size()));
+
+            THEN("the error output is collected once") {
+                REQUIRE(reactor.get_errors(bot.channel) == message);
+                REQUIRE(reactor.get_errors(bot.channel).empty());
+            }
+        }
+    }
+}
+
+/**
+ * Count the threads of the test program.
+ * @return The number of threads.
+ */
+static int count_threads() {
+    std::ifstream status("/proc/self/status");
+    std::string field;
+    while (status >> field) {
+        if (field == "Threads:") {
+            int threads = 0;
+            status >> threads;
+            return threads;
+        }
+    }
+    return 0;
+}
+
+SCENARIO("Reactor writes what a bot does not read at once", "[reactor]") {
+    GIVEN("A registered bot that has not read its input") {
+        BotPipes bot;
+        auto &reactor = Reactor::get();
+        const std::string message(256 * 1024, 'x');
+
+        WHEN("a message larger than the pipe is exchanged") {
+            auto reply = reactor.exchange(bot.channel, {message}, Framing::Line, 2000ms);
+            std::thread reader([&bot, &message] {
+                std::string received(message.size(), '\0');
+                size_t length = 0;
+                while (length < received.size()) {
+                    const auto bytes_read = read(bot.input[0], &received[length], received.size() - length);
+                    if (bytes_read > 0) {
+                        length += static_cast<size_t>(bytes_read);
+                    } else {
+                        std::this_thread::sleep_for(1ms);
+                    }
+                }
+                bot.write_output(std::to_string(length) + "\n");
+            });
+            const auto received = reply.get();
+            reader.join();
+
+            THEN("the message is sent as the bot reads, and the reply read after it") {
+                REQUIRE(received.message == std::to_string(message.size()));
+                REQUIRE(received.sent <= received.received);
+                const auto statistics = reactor.write_statistics(bot.channel);
+                REQUIRE(statistics.bytes_sent == message.size());
+                REQUIRE(statistics.blocked_writes == 1);
+            }
+        }
+
+        WHEN("the bot never reads its input") {
+            auto sent = reactor.send(bot.channel, {message}, 20ms);
+
+            THEN("sending times out") {
+                REQUIRE_THROWS_AS(sent.get(), TimeoutError);
+            }
+        }
+    }
+}
+
+SCENARIO("Reactor serves hundreds of bots without a thread for each", "[reactor]") {
+    GIVEN("Hundreds of bots echoing their input") {
+        static constexpr auto BOTS = 300;
+        // Each bot holds its three pipes and a timer open in the engine
+        rlimit files{};
+        REQUIRE(getrlimit(RLIMIT_NOFILE, &files) == 0);
+        if (files.rlim_cur < files.rlim_max) {
+            files.rlim_cur = files.rlim_max;
+            REQUIRE(setrlimit(RLIMIT_NOFILE, &files) == 0);
+        }
+        NetworkingConfig config{};
+        config.timeout = std::chrono::seconds(30);
+        std::vector<std::unique_ptr<UnixConnection>> bots;
+        std::vector<std::string> messages;
+        for (auto index = 0; index < BOTS; index++) {
+            bots.push_back(std::make_unique<UnixConnection>("cat", config));
+            messages.push_back("bot " + std::to_string(index) + "\n");
+        }
+        const auto threads = count_threads();
+
+        WHEN("every bot is sent a message before any reply is awaited") {
+            std::vector<std::future<Reply>> replies;
+            for (auto index = 0; index < BOTS; index++) {
+                replies.push_back(bots[index]->exchange({messages[index]}, Framing::Line, config.timeout));
+            }
+            const auto waiting_threads = count_threads();
+
+            THEN("every bot replies, while no thread was started to wait on them") {
+                REQUIRE(waiting_threads == threads);
+                for (auto index = 0; index < BOTS; index++) {
+                    REQUIRE(replies[index].get().message == "bot " + std::to_string(index));
+                }
+            }
+        }
+    }
+}
+
+#endif // __linux__
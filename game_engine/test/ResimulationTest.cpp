@@ -0,0 +1,55 @@
+#include "Replay.hpp"
+#include "Resimulation.hpp"
+#include "Simulation.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("Replays re-simulate to the recorded frames", "[resimulation]") {
+    GIVEN("The replay of a short game in which a player is removed") {
+        Constants::Scope scope;
+        Constants::get_mut().MIN_TURNS = Constants::get_mut().MAX_TURNS = 30;
+        Simulation simulation(true);
+        simulation.init({mapgen::MapType::Fractal, 5, 32, 32, 0}, 4);
+        const auto &observation = simulation.observe();
+        for (int turn = 0; !observation.done; turn++) {
+            std::vector<Simulation::Commands> commands(observation.players.size());
+            for (size_t player = 0; player < observation.players.size(); player++) {
+                if (turn % 3 == 0 && observation.players[player].energy >= Constants::get().NEW_ENTITY_ENERGY_COST) {
+                    commands[player].emplace_back(SpawnCommand());
+                }
+                for (const auto &entity : observation.players[player].entities) {
+                    const auto direction = (entity.id.value + turn) % 2 == 0 ? Direction::East : Direction::Still;
+                    commands[player].emplace_back(MoveCommand(entity.id, direction));
+                }
+            }
+            std::vector<Player::id_type> removed;
+            if (turn == 10) {
+                removed.emplace_back(3);
+            }
+            simulation.step(std::move(commands), removed);
+        }
+        nlohmann::json replay = simulation.get_replay();
+
+        WHEN("it is re-simulated") {
+            const auto report = resimulate(replay);
+            THEN("every turn is played and every frame matches") {
+                REQUIRE(report.turns == 30);
+                REQUIRE(report.matches);
+                REQUIRE(report.first_mismatch == -1);
+            }
+        }
+
+        WHEN("a recorded spawn is dropped") {
+            auto &moves = replay["full_frames"][4]["moves"]["0"];
+            REQUIRE(moves.front()["type"] == "g");
+            moves.erase(moves.begin());
+            const auto report = resimulate(replay);
+            THEN("the frame of that turn does not match") {
+                REQUIRE(!report.matches);
+                REQUIRE(report.first_mismatch == 4);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "Rules.hpp"
+#include "Simulation.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+namespace {
+
+/**
+ * Play a fixed script of spawns and moves, recording the state after every turn.
+ * @param simulation The simulation, already initialized.
+ * @param turns The number of turns to play.
+ * @return The energy of every player and entity after every turn.
+ */
+std::vector<energy_type> play_script(Simulation &simulation, int turns) {
+    static constexpr Direction directions[] = {Direction::North, Direction::Still, Direction::East,
+                                               Direction::Still, Direction::South, Direction::West};
+    std::vector<energy_type> trace;
+    const auto &observation = simulation.observe();
+    for (int turn = 0; turn < turns && !observation.done; turn++) {
+        std::vector<Simulation::Commands> commands(observation.players.size());
+        for (size_t player = 0; player < observation.players.size(); player++) {
+            if (turn % 4 == 0) {
+                commands[player].emplace_back(SpawnCommand());
+            }
+            for (const auto &entity : observation.players[player].entities) {
+                const auto direction = directions[(entity.id.value + turn) % std::size(directions)];
+                commands[player].emplace_back(MoveCommand(entity.id, direction));
+            }
+        }
+        simulation.step(std::move(commands));
+        for (const auto &player : observation.players) {
+            trace.push_back(player.energy);
+            for (const auto &entity : player.entities) {
+                trace.push_back(entity.energy);
+                trace.push_back(entity.is_inspired);
+            }
+        }
+    }
+    return trace;
+}
+
+}
+
+SCENARIO("The standard rules policy is selected only for standard constants", "[rules]") {
+    GIVEN("The default constants") {
+        Constants::Scope scope;
+        REQUIRE(StandardRules::matches(Constants::get()));
+
+        WHEN("a rule parameter is changed") {
+            Constants::get_mut().INSPIRATION_SHIP_COUNT = 3;
+            THEN("they no longer follow the standard rules") {
+                REQUIRE(!StandardRules::matches(Constants::get()));
+            }
+        }
+
+        WHEN("a parameter outside the per-turn rules is changed") {
+            Constants::get_mut().INITIAL_ENERGY = 60000;
+            THEN("they still follow the standard rules") {
+                REQUIRE(StandardRules::matches(Constants::get()));
+            }
+        }
+    }
+}
+
+SCENARIO("Both rules policies play standard games identically", "[rules]") {
+    const mapgen::MapParameters map_parameters{mapgen::MapType::Fractal, 7, 32, 32, 0};
+
+    GIVEN("One game with the standard policy and one with the runtime policy") {
+        Constants::Scope scope;
+        Constants::get_mut().INITIAL_ENERGY = 60000;
+        Simulation standard;
+        standard.init(map_parameters, 4);
+
+        // Capture is disabled, so its radius changes the policy but not the game.
+        Constants::get_mut().CAPTURE_RADIUS = StandardRules::CAPTURE_RADIUS + 1;
+        Simulation runtime;
+        runtime.init(map_parameters, 4);
+
+        THEN("they play the same script to the same states") {
+            const auto standard_trace = play_script(standard, 120);
+            const auto runtime_trace = play_script(runtime, 120);
+            REQUIRE(standard_trace.size() > 1000);
+            REQUIRE(standard_trace == runtime_trace);
+        }
+    }
+}
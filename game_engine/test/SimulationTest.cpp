@@ -0,0 +1,84 @@
+#include "Simulation.hpp"
+#include "Statistics.hpp"
+#include "Replay.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("Simulation plays games in process", "[simulation]") {
+    const mapgen::MapParameters map_parameters{mapgen::MapType::Fractal, 42, 32, 32, 0};
+
+    GIVEN("A new game with two players") {
+        Simulation simulation;
+        simulation.init(map_parameters, 2);
+        const auto &observation = simulation.observe();
+        REQUIRE(observation.turn_number == 1);
+        REQUIRE(!observation.done);
+        REQUIRE(observation.map->width == 32);
+        REQUIRE(observation.players.size() == 2);
+        const auto initial_energy = observation.players[0].energy;
+
+        WHEN("the first player spawns a ship") {
+            std::vector<Simulation::Commands> commands(1);
+            commands[0].emplace_back(SpawnCommand());
+            simulation.step(std::move(commands));
+            THEN("the ship is on the factory and paid for") {
+                const auto &player = observation.players[0];
+                REQUIRE(observation.turn_number == 2);
+                REQUIRE(player.entities.size() == 1);
+                REQUIRE(player.entities.front().location == player.factory);
+                REQUIRE(player.energy == initial_energy - Constants::get().NEW_ENTITY_ENERGY_COST);
+                REQUIRE(observation.players[1].entities.empty());
+            }
+            AND_WHEN("the ship moves") {
+                const auto ship = observation.players[0].entities.front();
+                commands.clear();
+                commands.resize(1);
+                commands[0].emplace_back(MoveCommand(ship.id, Direction::North));
+                simulation.step(std::move(commands));
+                THEN("it leaves the factory") {
+                    auto expected = ship.location;
+                    observation.map->move_location(expected, Direction::North);
+                    REQUIRE(observation.players[0].entities.front().location == expected);
+                }
+            }
+        }
+
+        WHEN("a player commands a ship it does not own") {
+            std::vector<Simulation::Commands> commands(2);
+            commands[1].emplace_back(ConstructCommand(Entity::id_type{0}));
+            simulation.step(std::move(commands));
+            THEN("that player is terminated") {
+                REQUIRE(observation.players[1].terminated);
+                REQUIRE(!observation.players[0].terminated);
+            }
+        }
+
+        WHEN("the game is played to the end") {
+            while (!simulation.step({})) {}
+            THEN("every turn was played and no replay was kept") {
+                REQUIRE(observation.done);
+                REQUIRE(simulation.statistics().number_turns == Constants::get().MAX_TURNS + 1);
+                REQUIRE(simulation.get_replay().full_frames.empty());
+            }
+            AND_WHEN("a new game is started") {
+                simulation.init(map_parameters, 2);
+                THEN("it starts over with the same constants") {
+                    REQUIRE(observation.turn_number == 1);
+                    REQUIRE(!observation.done);
+                    REQUIRE(observation.players[0].energy == initial_energy);
+                }
+            }
+        }
+    }
+
+    GIVEN("A game recording its replay") {
+        Simulation simulation(true);
+        simulation.init(map_parameters, 2);
+        simulation.step({});
+        THEN("the replay has the initial frame and the turn") {
+            REQUIRE(simulation.get_replay().full_frames.size() == 2);
+        }
+    }
+}
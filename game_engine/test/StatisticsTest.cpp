@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "nlohmann/json.hpp"
+
+#include "catch.hpp"
+
+#include "Statistics.hpp"
+
+using namespace hlt;
+
+SCENARIO("Distributions summarize per-turn measurements", "[statistics]") {
+    GIVEN("The measurements 1 to 200, shuffled") {
+        std::vector<long long> samples(200);
+        std::iota(samples.begin(), samples.end(), 1);
+        std::shuffle(samples.begin(), samples.end(), std::mt19937(7));
+
+        WHEN("they are summarized") {
+            const auto distribution = Distribution::of(samples);
+
+            THEN("the percentiles are those of nearest rank") {
+                REQUIRE(distribution.p50 == 100);
+                REQUIRE(distribution.p95 == 190);
+                REQUIRE(distribution.p99 == 198);
+                REQUIRE(distribution.max == 200);
+            }
+        }
+    }
+
+    GIVEN("A single measurement") {
+        WHEN("it is summarized") {
+            const auto distribution = Distribution::of({42});
+
+            THEN("every percentile is that measurement") {
+                REQUIRE(distribution.p50 == 42);
+                REQUIRE(distribution.p95 == 42);
+                REQUIRE(distribution.p99 == 42);
+                REQUIRE(distribution.max == 42);
+            }
+        }
+    }
+
+    GIVEN("No measurements, as for a player that never played a turn") {
+        WHEN("they are summarized") {
+            const nlohmann::json json = Distribution::of({});
+
+            THEN("every percentile is zero") {
+                REQUIRE(json == nlohmann::json({{"p50", 0}, {"p95", 0}, {"p99", 0}, {"max", 0}}));
+            }
+        }
+    }
+}
+
+SCENARIO("Timing is reported apart from the game statistics", "[statistics]") {
+    GIVEN("The statistics of a game in which a bot timed out") {
+        GameStatistics statistics;
+        statistics.player_statistics.emplace_back(Player::id_type(0), 0);
+        auto &player = statistics.player_statistics.back();
+        player.turn_response_times = {1200, 2000000};
+        player.turn_bytes_sent = {300, 40};
+        player.turn_bytes_received = {12, 0};
+        player.failed_turns = 1;
+        statistics.turn_engine_times = {150, 90};
+
+        WHEN("they are converted to JSON") {
+            const nlohmann::json json = statistics;
+
+            THEN("no measurement is included, so replays of a game are the same") {
+                REQUIRE(json.count("timing") == 0);
+                REQUIRE(json["player_statistics"][0].count("timing") == 0);
+            }
+        }
+
+        WHEN("the timing is summarized") {
+            const auto summary = timing_summary(statistics);
+            const auto &timing = summary["players"]["0"];
+
+            THEN("the failed turn counts, with the time it was waited for") {
+                REQUIRE(timing["failed_turns"] == 1);
+                REQUIRE(timing["response_time_us"]["max"] == 2000000);
+                REQUIRE(timing["bytes_sent"] == 340);
+                REQUIRE(summary["engine_turn_time_us"]["max"] == 150);
+            }
+        }
+    }
+}
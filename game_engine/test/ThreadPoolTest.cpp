@@ -0,0 +1,55 @@
+#include <atomic>
+#include <chrono>
+
+#include "Constants.hpp"
+#include "ThreadPool.hpp"
+
+#include "catch.hpp"
+
+using namespace hlt;
+
+SCENARIO("ThreadPool runs every submitted task", "[thread_pool]") {
+    GIVEN("A pool with several workers") {
+        ThreadPool pool(4);
+        std::atomic<int> completed{0};
+
+        WHEN("tasks of uneven length are submitted") {
+            for (int task = 0; task < 64; task++) {
+                pool.submit([&completed, task] {
+                    if (task % 8 == 0) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    }
+                    completed++;
+                });
+            }
+            pool.wait();
+            THEN("all of them finish before wait returns") {
+                REQUIRE(completed == 64);
+            }
+        }
+    }
+}
+
+SCENARIO("Constants scopes are private to their thread", "[thread_pool]") {
+    GIVEN("Games on pool threads that each change their constants") {
+        const auto process_max_turns = Constants::get().MAX_TURNS;
+        std::vector<unsigned long> seen(8);
+        {
+            ThreadPool pool(4);
+            for (size_t game = 0; game < seen.size(); game++) {
+                pool.submit([&seen, game] {
+                    Constants::Scope scope;
+                    Constants::get_mut().MAX_TURNS = game;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    seen[game] = Constants::get().MAX_TURNS;
+                });
+            }
+        }
+        THEN("each game sees only its own change, and the process constants are untouched") {
+            for (size_t game = 0; game < seen.size(); game++) {
+                REQUIRE(seen[game] == game);
+            }
+            REQUIRE(Constants::get().MAX_TURNS == process_max_turns);
+        }
+    }
+}
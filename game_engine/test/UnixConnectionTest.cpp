@@ -0,0 +1,56 @@
+#ifndef _WIN32
+
+#include "UnixConnection.hpp"
+
+#include "catch.hpp"
+
+using namespace net;
+
+SCENARIO("UnixConnection waits for a slow bot to read large messages", "[connection]") {
+    GIVEN("A bot that reads its input only after a delay") {
+        NetworkingConfig config{};
+        config.timeout = std::chrono::seconds(10);
+        UnixConnection connection("sleep 0.2; head -c 300000 | wc -c", config);
+
+        WHEN("a message larger than the pipe buffer is sent in several buffers") {
+            const std::string first(100000, 'a');
+            const std::string second(150000, 'b');
+            const std::string third(50000, 'c');
+            connection.send_buffers({first, second, third});
+
+            THEN("the bot receives every byte") {
+                REQUIRE(connection.get_string() == "300000");
+            }
+            AND_THEN("the wait for the bot is recorded") {
+                const auto statistics = connection.write_statistics();
+                REQUIRE(statistics.bytes_sent == 300000);
+                REQUIRE(statistics.blocked_writes > 0);
+                REQUIRE(statistics.blocked_time > std::chrono::milliseconds(100));
+            }
+        }
+    }
+}
+
+SCENARIO("ConnectionPool keeps bots by the command that launched them", "[connection]") {
+    GIVEN("A pool holding a bot") {
+        NetworkingConfig config{};
+        config.timeout = std::chrono::seconds(10);
+        ConnectionPool pool;
+        pool.put("cat", std::make_unique<UnixConnection>("cat", config));
+
+        WHEN("bots are taken") {
+            auto other = pool.take("head");
+            auto kept = pool.take("cat");
+
+            THEN("only the bot launched with the same command is given, and still runs") {
+                REQUIRE(other == nullptr);
+                REQUIRE(kept != nullptr);
+                REQUIRE(pool.take("cat") == nullptr);
+                kept->send_string("next game\n");
+                REQUIRE(kept->get_string() == "next game");
+            }
+        }
+    }
+}
+
+#endif // _WIN32
@@ -0,0 +1,109 @@
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+
+/**
+ * Start the worker threads.
+ * @param num_threads The number of workers, at least one.
+ */
+ThreadPool::ThreadPool(size_t num_threads) {
+    num_threads = std::max<size_t>(num_threads, 1);
+    for (size_t index = 0; index < num_threads; index++) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+    for (size_t index = 0; index < num_threads; index++) {
+        threads.emplace_back(&ThreadPool::work, this, index);
+    }
+}
+
+/**
+ * Queue a task.
+ * @param task The task.
+ */
+void ThreadPool::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto &queue = *queues[next_queue];
+        next_queue = (next_queue + 1) % queues.size();
+        std::lock_guard<std::mutex> queue_guard(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+        queued++;
+        pending++;
+    }
+    work_available.notify_one();
+}
+
+/** Wait until all submitted tasks have finished. */
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    all_done.wait(lock, [this] { return pending == 0; });
+}
+
+/** Finish all submitted tasks, then stop the worker threads. */
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * Take a task, from the back of a worker's own queue or else from the front of another.
+ * @param index The index of the worker.
+ * @param[out] task The task taken.
+ * @return True if a task was taken.
+ */
+bool ThreadPool::take(size_t index, Task &task) {
+    {
+        auto &own = *queues[index];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        auto &victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Run tasks until the pool stops.
+ * @param index The index of the worker.
+ */
+void ThreadPool::work(size_t index) {
+    Task task;
+    while (true) {
+        if (take(index, task)) {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                queued--;
+            }
+            task();
+            task = nullptr;
+            std::lock_guard<std::mutex> guard(mutex);
+            if (--pending == 0) {
+                all_done.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        work_available.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads with work stealing.
+ *
+ * Each worker has its own queue, and tasks are dealt to the queues in turn. A worker
+ * takes tasks from the back of its own queue, and once that is empty, steals from
+ * the front of the others, so that long and short tasks balance out across workers.
+ */
+class ThreadPool final {
+public:
+    /** The type of tasks, which must not throw. */
+    using Task = std::function<void()>;
+
+private:
+    /** The queue of a worker. */
+    struct Queue {
+        std::mutex mutex;       /**< Guards the tasks. */
+        std::deque<Task> tasks; /**< The tasks. */
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; /**< The queue of each worker. */
+    std::vector<std::thread> threads;           /**< The worker threads. */
+    std::mutex mutex;                           /**< Guards the counters below. */
+    std::condition_variable work_available;     /**< Signalled when tasks are queued or the pool stops. */
+    std::condition_variable all_done;           /**< Signalled when no tasks are pending. */
+    size_t queued = 0;                          /**< The number of tasks waiting in queues. */
+    size_t pending = 0;                         /**< The number of tasks not yet finished. */
+    size_t next_queue = 0;                      /**< The queue receiving the next task. */
+    bool stopping = false;                      /**< Whether the workers should exit. */
+
+    /**
+     * Take a task, from the back of a worker's own queue or else from the front of another.
+     * @param index The index of the worker.
+     * @param[out] task The task taken.
+     * @return True if a task was taken.
+     */
+    bool take(size_t index, Task &task);
+
+    /**
+     * Run tasks until the pool stops.
+     * @param index The index of the worker.
+     */
+    void work(size_t index);
+
+public:
+    /**
+     * Start the worker threads.
+     * @param num_threads The number of workers, at least one.
+     */
+    explicit ThreadPool(size_t num_threads);
+
+    /**
+     * Queue a task.
+     * @param task The task.
+     */
+    void submit(Task task);
+
+    /**
+     * Queue a function, and get a future for its result or exception.
+     * @tparam Function The type of the function.
+     * @param function The function.
+     * @return The future.
+     */
+    template<class Function>
+    auto run(Function function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        // Tasks must be copyable, so the packaged task is shared.
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        auto future = task->get_future();
+        submit([task] { (*task)(); });
+        return future;
+    }
+
+    /** Wait until all submitted tasks have finished. */
+    void wait();
+
+    /** Finish all submitted tasks, then stop the worker threads. */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+};
+
+#endif // THREADPOOL_HPP
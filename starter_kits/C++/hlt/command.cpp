@@ -1,19 +1,24 @@
 #include "command.hpp"
 
-#include <iostream>
-
-constexpr char GENERATE= 'g';
-constexpr char CONSTRUCT[] = "c ";
-constexpr char MOVE[] = "m ";
+std::string hlt::Command::to_string() const {
+    switch (type) {
+        case CONSTRUCT:
+            return std::string(1, type) + ' ' + std::to_string(entity_id);
+        case MOVE:
+            return std::string(1, type) + ' ' + std::to_string(entity_id) + ' ' + static_cast<char>(direction);
+        default:
+            return std::string(1, type);
+    }
+}
 
 hlt::Command hlt::command::spawn_ship() {
-    return std::string(1, GENERATE);
+    return { Command::GENERATE, 0, Direction::STILL };
 }
 
 hlt::Command hlt::command::transform_ship_into_dropoff_site(EntityId id) {
-    return CONSTRUCT + std::to_string(id);
+    return { Command::CONSTRUCT, id, Direction::STILL };
 }
 
 hlt::Command hlt::command::move(EntityId id, hlt::Direction direction) {
-    return MOVE + std::to_string(id) + ' ' + static_cast<char>(direction);
+    return { Command::MOVE, id, direction };
 }
@@ -6,7 +6,20 @@
 #include <string>
 
 namespace hlt {
-    typedef std::string Command;
+    struct Command {
+        static constexpr char GENERATE = 'g';
+        static constexpr char CONSTRUCT = 'c';
+        static constexpr char MOVE = 'm';
+
+        char type;
+        // Unused by GENERATE.
+        EntityId entity_id;
+        // Only used by MOVE.
+        Direction direction;
+
+        // The command as sent in the text protocol.
+        std::string to_string() const;
+    };
 
     namespace command {
         Command spawn_ship();
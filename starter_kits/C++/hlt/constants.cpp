@@ -21,6 +21,8 @@ namespace hlt {
         int INSPIRED_EXTRACT_RATIO;
         double INSPIRED_BONUS_MULTIPLIER;
         int INSPIRED_MOVE_COST_RATIO;
+        int BINARY_PROTOCOL;
+        int MULTI_GAME;
     }
 }
 
@@ -108,4 +110,8 @@ void hlt::constants::populate_constants(const std::string& string_from_engine) {
     INSPIRED_EXTRACT_RATIO = get_int(constants_map, "INSPIRED_EXTRACT_RATIO");
     INSPIRED_BONUS_MULTIPLIER = get_double(constants_map, "INSPIRED_BONUS_MULTIPLIER");
     INSPIRED_MOVE_COST_RATIO = get_int(constants_map, "INSPIRED_MOVE_COST_RATIO");
+    // Engines that predate the binary protocol do not offer it
+    BINARY_PROTOCOL = constants_map.count("binary_protocol") ? get_int(constants_map, "binary_protocol") : 0;
+    // Engines only offer multi-game play when they can run several games
+    MULTI_GAME = constants_map.count("multi_game") ? get_int(constants_map, "multi_game") : 0;
 }
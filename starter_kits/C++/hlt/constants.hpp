@@ -35,5 +35,9 @@ namespace hlt {
         extern double INSPIRED_BONUS_MULTIPLIER;
         /** An inspired ship instead spends 1/X% halite to move. */
         extern int INSPIRED_MOVE_COST_RATIO;
+        /** The version of the binary protocol offered by the engine, or 0 if none is offered. */
+        extern int BINARY_PROTOCOL;
+        /** The version of multi-game play offered by the engine, or 0 if none is offered. */
+        extern int MULTI_GAME;
     }
 }
@@ -9,3 +9,11 @@ std::shared_ptr<hlt::Dropoff> hlt::Dropoff::_generate(hlt::PlayerId player_id) {
 
     return std::make_shared<hlt::Dropoff>(player_id, dropoff_id, x, y);
 }
+
+std::shared_ptr<hlt::Dropoff> hlt::Dropoff::_generate(hlt::PlayerId player_id, hlt::BinaryInput& input) {
+    hlt::EntityId dropoff_id = input.get_int();
+    int x = input.get_int();
+    int y = input.get_int();
+
+    return std::make_shared<hlt::Dropoff>(player_id, dropoff_id, x, y);
+}
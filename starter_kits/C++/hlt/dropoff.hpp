@@ -5,9 +5,12 @@
 #include <memory>
 
 namespace hlt {
+    struct BinaryInput;
+
     struct Dropoff : Entity {
         using Entity::Entity;
 
         static std::shared_ptr<Dropoff> _generate(PlayerId player_id);
+        static std::shared_ptr<Dropoff> _generate(PlayerId player_id, BinaryInput& input);
     };
 }
@@ -1,10 +1,34 @@
 #include "game.hpp"
 #include "input.hpp"
 
+#include <cstdint>
 #include <sstream>
 
-hlt::Game::Game() : turn_number(0) {
-    std::ios_base::sync_with_stdio(false);
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+// The version of the binary protocol that the starter kit speaks.
+constexpr int BINARY_PROTOCOL_VERSION = 1;
+// The version of multi-game play that the starter kit speaks.
+constexpr int MULTI_GAME_VERSION = 1;
+// The turn number that ends a game, sent only to bots playing several games.
+constexpr int GAME_OVER_TURN = 0;
+
+// Appends a 32-bit little-endian integer, as in the binary protocol.
+static void append_int(std::string& record, int value) {
+    uint32_t bits = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; ++i) {
+        record.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+hlt::Game::Game() : turn_number(0), binary_protocol(false), multi_game(false) {
+    static bool first_game = true;
+    if (first_game) {
+        std::ios_base::sync_with_stdio(false);
+    }
 
     hlt::constants::populate_constants(hlt::get_string());
 
@@ -12,7 +36,11 @@ hlt::Game::Game() : turn_number(0) {
     std::stringstream input(get_string());
     input >> num_players >> my_id;
 
-    log::open(my_id);
+    // A bot playing several games keeps logging to the file of its first game.
+    if (first_game) {
+        log::open(my_id);
+        first_game = false;
+    }
 
     for (int i = 0; i < num_players; ++i) {
         players.push_back(Player::_generate());
@@ -21,25 +49,49 @@ hlt::Game::Game() : turn_number(0) {
     game_map = GameMap::_generate();
 }
 
-void hlt::Game::ready(const std::string& name) {
-    std::cout << name << std::endl;
+void hlt::Game::ready(const std::string& name, bool accept_multi_game) {
+    // Accept offers by following the name with them.
+    std::cout << name;
+    if (constants::BINARY_PROTOCOL == BINARY_PROTOCOL_VERSION) {
+        std::cout << " binary_protocol=" << BINARY_PROTOCOL_VERSION;
+        binary_protocol = true;
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    }
+    if (accept_multi_game && constants::MULTI_GAME == MULTI_GAME_VERSION) {
+        std::cout << " multi_game=" << MULTI_GAME_VERSION;
+        multi_game = true;
+    }
+    std::cout << std::endl;
 }
 
-void hlt::Game::update_frame() {
-    hlt::get_sstream() >> turn_number;
-    log::log("=============== TURN " + std::to_string(turn_number) + " ================");
+bool hlt::Game::update_frame() {
+    if (binary_protocol) {
+        if (!update_frame_binary()) {
+            return false;
+        }
+    } else {
+        hlt::get_sstream() >> turn_number;
+        if (multi_game && turn_number == GAME_OVER_TURN) {
+            log::log("=============== GAME OVER ================");
+            return false;
+        }
+        log::log("=============== TURN " + std::to_string(turn_number) + " ================");
 
-    for (size_t i = 0; i < players.size(); ++i) {
-        PlayerId current_player_id;
-        int num_ships;
-        int num_dropoffs;
-        Halite halite;
-        hlt::get_sstream() >> current_player_id >> num_ships >> num_dropoffs >> halite;
+        for (size_t i = 0; i < players.size(); ++i) {
+            PlayerId current_player_id;
+            int num_ships;
+            int num_dropoffs;
+            Halite halite;
+            hlt::get_sstream() >> current_player_id >> num_ships >> num_dropoffs >> halite;
 
-        players[current_player_id]->_update(num_ships, num_dropoffs, halite);
-    }
+            players[current_player_id]->_update(num_ships, num_dropoffs, halite);
+        }
 
-    game_map->_update();
+        game_map->_update();
+    }
 
     for (const auto& player : players) {
         for (auto& ship_iterator : player->ships) {
@@ -54,12 +106,61 @@ void hlt::Game::update_frame() {
             game_map->at(dropoff)->structure = dropoff;
         }
     }
+    return true;
+}
+
+bool hlt::Game::update_frame_binary() {
+    // The same fields as the text protocol, in the same order, in one record.
+    hlt::BinaryInput input = hlt::get_record();
+    turn_number = input.get_int();
+    if (multi_game && turn_number == GAME_OVER_TURN) {
+        log::log("=============== GAME OVER ================");
+        return false;
+    }
+    log::log("=============== TURN " + std::to_string(turn_number) + " ================");
+
+    for (size_t i = 0; i < players.size(); ++i) {
+        PlayerId current_player_id = input.get_int();
+        int num_ships = input.get_int();
+        int num_dropoffs = input.get_int();
+        Halite halite = input.get_int();
+
+        players[current_player_id]->_update(num_ships, num_dropoffs, halite, input);
+    }
+
+    game_map->_update(input);
+    return true;
 }
 
 bool hlt::Game::end_turn(const std::vector<hlt::Command>& commands) {
+    if (binary_protocol) {
+        return end_turn_binary(commands);
+    }
+
     for (const auto& command : commands) {
-        std::cout << command << ' ';
+        std::cout << command.to_string() << ' ';
     }
     std::cout << std::endl;
     return std::cout.good();
 }
+
+bool hlt::Game::end_turn_binary(const std::vector<hlt::Command>& commands) {
+    // Each command is its type, then the entity as an integer, then the direction for moves.
+    std::string record;
+    for (const auto& command : commands) {
+        record.push_back(command.type);
+        if (command.type != Command::GENERATE) {
+            append_int(record, command.entity_id);
+        }
+        if (command.type == Command::MOVE) {
+            record.push_back(static_cast<char>(command.direction));
+        }
+    }
+
+    std::string length;
+    append_int(length, static_cast<int>(record.size()));
+    std::cout.write(length.data(), length.size());
+    std::cout.write(record.data(), record.size());
+    std::cout.flush();
+    return std::cout.good();
+}
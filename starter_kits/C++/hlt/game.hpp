@@ -14,10 +14,16 @@ namespace hlt {
         std::vector<std::shared_ptr<Player>> players;
         std::shared_ptr<Player> me;
         std::unique_ptr<GameMap> game_map;
+        bool binary_protocol;
+        bool multi_game;
 
         Game();
-        void ready(const std::string& name);
-        void update_frame();
+        void ready(const std::string& name, bool accept_multi_game = false);
+        bool update_frame();
         bool end_turn(const std::vector<Command>& commands);
+
+    private:
+        bool update_frame_binary();
+        bool end_turn_binary(const std::vector<Command>& commands);
     };
 }
@@ -20,6 +20,23 @@ void hlt::GameMap::_update() {
     }
 }
 
+void hlt::GameMap::_update(BinaryInput& input) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            cells[y][x].ship.reset();
+        }
+    }
+
+    int update_count = input.get_int();
+
+    for (int i = 0; i < update_count; ++i) {
+        int x = input.get_int();
+        int y = input.get_int();
+        int halite = input.get_int();
+        cells[y][x].halite = halite;
+    }
+}
+
 std::unique_ptr<hlt::GameMap> hlt::GameMap::_generate() {
     std::unique_ptr<hlt::GameMap> map = std::make_unique<GameMap>();
 
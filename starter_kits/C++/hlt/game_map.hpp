@@ -6,6 +6,8 @@
 #include <vector>
 
 namespace hlt {
+    struct BinaryInput;
+
     struct GameMap {
         int width;
         int height;
@@ -87,6 +89,7 @@ namespace hlt {
         }
 
         void _update();
+        void _update(BinaryInput& input);
         static std::unique_ptr<GameMap> _generate();
     };
 }
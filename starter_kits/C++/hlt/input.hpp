@@ -2,6 +2,7 @@
 
 #include "log.hpp"
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -20,4 +21,38 @@ namespace hlt {
     static std::stringstream get_sstream() {
         return std::stringstream(get_string());
     }
+
+    // A record of the binary protocol: 32-bit little-endian integers.
+    struct BinaryInput {
+        std::string record;
+        size_t position;
+
+        int get_int() {
+            if (position + 4 > record.size()) {
+                hlt::log::log("Error: binary record from server ended early. Exiting...");
+                exit(1);
+            }
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<uint32_t>(static_cast<unsigned char>(record[position++])) << (8 * i);
+            }
+            return static_cast<int>(static_cast<int32_t>(value));
+        }
+    };
+
+    // Reads a record prefixed by its length, as a 32-bit little-endian integer.
+    static BinaryInput get_record() {
+        BinaryInput length{std::string(4, '\0'), 0};
+        std::cin.read(&length.record[0], 4);
+        BinaryInput input{std::string(), 0};
+        if (std::cin.good()) {
+            input.record.resize(static_cast<uint32_t>(length.get_int()));
+            std::cin.read(&input.record[0], input.record.size());
+        }
+        if (!std::cin.good()) {
+            hlt::log::log("Input connection from server closed. Exiting...");
+            exit(0);
+        }
+        return input;
+    }
 }
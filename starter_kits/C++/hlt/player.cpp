@@ -17,6 +17,22 @@ void hlt::Player::_update(int num_ships, int num_dropoffs, Halite halite) {
     }
 }
 
+void hlt::Player::_update(int num_ships, int num_dropoffs, Halite halite, BinaryInput& input) {
+    this->halite = halite;
+
+    ships.clear();
+    for (int i = 0; i < num_ships; ++i) {
+        std::shared_ptr<hlt::Ship> ship = hlt::Ship::_generate(id, input);
+        ships[ship->id] = ship;
+    }
+
+    dropoffs.clear();
+    for (int i = 0; i < num_dropoffs; ++i) {
+        std::shared_ptr<hlt::Dropoff> dropoff = hlt::Dropoff::_generate(id, input);
+        dropoffs[dropoff->id] = dropoff;
+    }
+}
+
 std::shared_ptr<hlt::Player> hlt::Player::_generate() {
     PlayerId player_id;
     int shipyard_x;
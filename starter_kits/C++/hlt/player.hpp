@@ -9,6 +9,8 @@
 #include <unordered_map>
 
 namespace hlt {
+    struct BinaryInput;
+
     struct Player {
         PlayerId id;
         std::shared_ptr<Shipyard> shipyard;
@@ -23,6 +25,7 @@ namespace hlt {
         {}
 
         void _update(int num_ships, int num_dropoffs, Halite halite);
+        void _update(int num_ships, int num_dropoffs, Halite halite, BinaryInput& input);
         static std::shared_ptr<Player> _generate();
     };
 }
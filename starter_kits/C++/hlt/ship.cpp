@@ -10,3 +10,12 @@ std::shared_ptr<hlt::Ship> hlt::Ship::_generate(hlt::PlayerId player_id) {
 
     return std::make_shared<hlt::Ship>(player_id, ship_id, x, y, halite);
 }
+
+std::shared_ptr<hlt::Ship> hlt::Ship::_generate(hlt::PlayerId player_id, hlt::BinaryInput& input) {
+    hlt::EntityId ship_id = input.get_int();
+    int x = input.get_int();
+    int y = input.get_int();
+    hlt::Halite halite = input.get_int();
+
+    return std::make_shared<hlt::Ship>(player_id, ship_id, x, y, halite);
+}
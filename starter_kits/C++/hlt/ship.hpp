@@ -7,6 +7,8 @@
 #include <memory>
 
 namespace hlt {
+    struct BinaryInput;
+
     struct Ship : Entity {
         Halite halite;
 
@@ -32,5 +34,6 @@ namespace hlt {
         }
 
         static std::shared_ptr<Ship> _generate(PlayerId player_id);
+        static std::shared_ptr<Ship> _generate(PlayerId player_id, BinaryInput& input);
     };
 }